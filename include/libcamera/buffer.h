@@ -17,6 +17,18 @@ class BufferPool;
 class Request;
 class Stream;
 
+enum MappingPolicy {
+	MapOnDemand,
+	MapReadOnly,
+	MapPrefault,
+	MapNever,
+};
+
+struct MappingStatistics {
+	unsigned long mmaps;
+	unsigned long munmaps;
+};
+
 class Plane final
 {
 public:
@@ -29,15 +41,23 @@ public:
 	void *mem();
 	unsigned int length() const { return length_; }
 
+	static MappingStatistics statistics();
+
 private:
+	friend class BufferPool;
+	friend class CpuAccess;
 	friend class Stream;
 
+	void setMappingPolicy(MappingPolicy policy);
+	int sync(uint64_t flags);
+
 	int mmap();
 	int munmap();
 
 	int fd_;
 	unsigned int length_;
 	void *mem_;
+	MappingPolicy policy_;
 };
 
 class BufferMemory final
@@ -49,9 +69,38 @@ private:
 	std::vector<Plane> planes_;
 };
 
+class CpuAccess final
+{
+public:
+	enum Flags {
+		Read = 1 << 0,
+		Write = 1 << 1,
+		ReadWrite = Read | Write,
+	};
+
+	CpuAccess(Plane *plane, unsigned int flags);
+	CpuAccess(BufferMemory *mem, unsigned int flags);
+	CpuAccess(const CpuAccess &) = delete;
+	CpuAccess &operator=(const CpuAccess &) = delete;
+	~CpuAccess();
+
+	bool isValid() const { return valid_; }
+
+private:
+	int start(Plane *plane);
+	void end(Plane *plane);
+	uint64_t syncDirection() const;
+
+	Plane *plane_;
+	BufferMemory *mem_;
+	unsigned int flags_;
+	bool valid_;
+};
+
 class BufferPool final
 {
 public:
+	BufferPool();
 	~BufferPool();
 
 	void createBuffers(unsigned int count);
@@ -60,8 +109,16 @@ public:
 	unsigned int count() const { return buffers_.size(); }
 	std::vector<BufferMemory> &buffers() { return buffers_; }
 
+	MappingPolicy mappingPolicy() const { return policy_; }
+	void setMappingPolicy(MappingPolicy policy);
+
+	bool persistent() const { return persistent_; }
+	void setPersistent(bool persistent) { persistent_ = persistent; }
+
 private:
 	std::vector<BufferMemory> buffers_;
+	MappingPolicy policy_;
+	bool persistent_;
 };
 
 class Buffer final
@@ -111,6 +168,10 @@ private:
 	Status status_;
 	Request *request_;
 	Stream *stream_;
+
+	bool traced_;
+	uint64_t traceQueued_;
+	uint64_t traceDequeued_;
 };
 
 } /* namespace libcamera */
@@ -12,6 +12,7 @@
 #include <set>
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 #include <libcamera/controls.h>
 #include <libcamera/request.h>
@@ -21,9 +22,26 @@
 namespace libcamera {
 
 class Buffer;
+class LatencyHistogram;
 class PipelineHandler;
 class Request;
 
+enum LatencyStage {
+	LatencyCamera,
+	LatencyPipeline,
+	LatencyDevice,
+	LatencyCompletion,
+	LatencyTotal,
+	LatencyStageCount,
+};
+
+struct LatencyStatistics {
+	uint64_t count;
+	uint64_t p50;
+	uint64_t p99;
+	uint64_t max;
+};
+
 class CameraConfiguration
 {
 public:
@@ -79,7 +97,7 @@ public:
 	const std::string &name() const;
 
 	Signal<Request *, Buffer *> bufferCompleted;
-	Signal<Request *, const std::map<Stream *, Buffer *> &> requestCompleted;
+	Signal<Request *, const Request::BufferMap &> requestCompleted;
 	Signal<Camera *> disconnected;
 
 	int acquire();
@@ -88,11 +106,13 @@ public:
 	const ControlInfoMap &controls();
 
 	const std::set<Stream *> &streams() const;
+	std::map<Stream *, StreamStatistics> statistics();
 	std::unique_ptr<CameraConfiguration> generateConfiguration(const StreamRoles &roles);
 	int configure(CameraConfiguration *config);
 
 	int allocateBuffers();
 	int freeBuffers();
+	int addBuffers(Stream *stream, unsigned int count);
 
 	Request *createRequest(uint64_t cookie = 0);
 	int queueRequest(Request *request);
@@ -100,6 +120,9 @@ public:
 	int start();
 	int stop();
 
+	void setTracing(bool enable);
+	LatencyStatistics latency(LatencyStage stage) const;
+
 private:
 	enum State {
 		CameraAvailable,
@@ -118,15 +141,24 @@ private:
 	friend class PipelineHandler;
 	void disconnect();
 
+	friend class Request;
+
 	void requestComplete(Request *request);
+	void traceRequest(Request *request);
 
 	std::shared_ptr<PipelineHandler> pipe_;
 	std::string name_;
 	std::set<Stream *> streams_;
 	std::set<Stream *> activeStreams_;
 
+	std::vector<Request *> requestPool_;
+	Request *completedRequest_;
+
 	bool disconnected_;
 	State state_;
+
+	bool tracing_;
+	std::unique_ptr<LatencyHistogram[]> latency_;
 };
 
 } /* namespace libcamera */
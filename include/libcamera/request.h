@@ -7,10 +7,10 @@
 #ifndef __LIBCAMERA_REQUEST_H__
 #define __LIBCAMERA_REQUEST_H__
 
-#include <map>
+#include <array>
 #include <memory>
 #include <stdint.h>
-#include <unordered_set>
+#include <utility>
 
 #include <libcamera/controls.h>
 #include <libcamera/signal.h>
@@ -21,7 +21,6 @@ class Buffer;
 class Camera;
 class Stream;
 
-
 class Request
 {
 public:
@@ -31,20 +30,61 @@ public:
 		RequestCancelled,
 	};
 
+	enum TracePoint {
+		TraceQueued,
+		TracePipelineQueued,
+		TraceDeviceQueued,
+		TraceDeviceDequeued,
+		TraceCompleted,
+		TracePointCount,
+	};
+
+	static constexpr unsigned int MaxBuffers = 4;
+
+	class BufferMap
+	{
+	public:
+		using value_type = std::pair<Stream *, Buffer *>;
+		using const_iterator = const value_type *;
+
+		BufferMap()
+			: size_(0) {}
+
+		const_iterator begin() const { return entries_.data(); }
+		const_iterator end() const { return entries_.data() + size_; }
+		const_iterator find(Stream *stream) const;
+
+		bool empty() const { return size_ == 0; }
+		unsigned int size() const { return size_; }
+
+	private:
+		friend class Request;
+
+		bool insert(Stream *stream, Buffer *buffer);
+		void clear() { size_ = 0; }
+
+		std::array<value_type, MaxBuffers> entries_;
+		unsigned int size_;
+	};
+
 	Request(Camera *camera, uint64_t cookie = 0);
 	Request(const Request &) = delete;
 	Request &operator=(const Request &) = delete;
 	~Request();
 
 	ControlList &controls() { return controls_; }
-	const std::map<Stream *, Buffer *> &buffers() const { return bufferMap_; }
+	const BufferMap &buffers() const { return bufferMap_; }
 	int addBuffer(std::unique_ptr<Buffer> buffer);
 	Buffer *findBuffer(Stream *stream) const;
 
+	void reuse();
+
 	uint64_t cookie() const { return cookie_; }
 	Status status() const { return status_; }
 
-	bool hasPendingBuffers() const { return !pending_.empty(); }
+	bool hasPendingBuffers() const { return pendingCount_ != 0; }
+
+	uint64_t traceTimestamp(TracePoint point) const { return trace_[point]; }
 
 private:
 	friend class Camera;
@@ -52,17 +92,21 @@ private:
 
 	int prepare();
 	void complete();
+	void reset();
 
 	bool completeBuffer(Buffer *buffer);
 
 	Camera *camera_;
 	ControlList controls_;
-	std::map<Stream *, Buffer *> bufferMap_;
-	std::unordered_set<Buffer *> pending_;
+	BufferMap bufferMap_;
+	std::array<Buffer *, MaxBuffers> pending_;
+	unsigned int pendingCount_;
 
-	const uint64_t cookie_;
+	uint64_t cookie_;
 	Status status_;
 	bool cancelled_;
+
+	std::array<uint64_t, TracePointCount> trace_;
 };
 
 } /* namespace libcamera */
@@ -7,7 +7,8 @@
 #ifndef __LIBCAMERA_SIGNAL_H__
 #define __LIBCAMERA_SIGNAL_H__
 
-#include <list>
+#include <algorithm>
+#include <new>
 #include <tuple>
 #include <type_traits>
 #include <vector>
@@ -37,6 +38,9 @@ public:
 	virtual void invokePack(void *pack) = 0;
 
 protected:
+	static void *allocatePack(std::size_t size);
+	static void freePack(void *pack);
+
 	void *obj_;
 	Object *object_;
 };
@@ -71,7 +75,8 @@ private:
 	{
 		PackType *args = static_cast<PackType *>(pack);
 		invoke(std::get<S>(*args)...);
-		delete args;
+		args->~PackType();
+		SlotBase::freePack(args);
 	}
 
 public:
@@ -98,9 +103,10 @@ public:
 
 	void activate(Args... args)
 	{
-		if (this->object_)
-			SlotBase::activatePack(new PackType{ args... });
-		else
+		if (this->object_) {
+			void *pack = SlotBase::allocatePack(sizeof(PackType));
+			SlotBase::activatePack(new (pack) PackType{ args... });
+		} else
 			(static_cast<T *>(this->obj_)->*func_)(args...);
 	}
 
@@ -135,20 +141,41 @@ public:
 	template<typename T>
 	void disconnect(T *obj)
 	{
-		for (auto iter = slots_.begin(); iter != slots_.end(); ) {
-			SlotBase *slot = *iter;
-			if (slot->match(obj)) {
-				iter = slots_.erase(iter);
-				delete slot;
-			} else {
-				++iter;
-			}
+		for (SlotBase *&slot : slots_) {
+			if (slot && slot->match(obj))
+				removeSlot(slot);
 		}
+
+		compact();
 	}
 
 protected:
 	friend class Object;
-	std::list<SlotBase *> slots_;
+
+	SignalBase()
+		: emitting_(0), removed_(false), destroyed_(nullptr) {}
+
+	void removeSlot(SlotBase *&slot)
+	{
+		delete slot;
+		slot = nullptr;
+		removed_ = true;
+	}
+
+	void compact()
+	{
+		if (emitting_ || !removed_)
+			return;
+
+		auto end = std::remove(slots_.begin(), slots_.end(), nullptr);
+		slots_.erase(end, slots_.end());
+		removed_ = false;
+	}
+
+	std::vector<SlotBase *> slots_;
+	unsigned int emitting_;
+	bool removed_;
+	bool *destroyed_;
 };
 
 template<typename... Args>
@@ -158,7 +185,14 @@ public:
 	Signal() {}
 	~Signal()
 	{
+		/* Notify the emissions in progress that the signal is gone. */
+		if (destroyed_)
+			*destroyed_ = true;
+
 		for (SlotBase *slot : slots_) {
+			if (!slot)
+				continue;
+
 			slot->disconnect(this);
 			delete slot;
 		}
@@ -189,9 +223,12 @@ public:
 
 	void disconnect()
 	{
-		for (SlotBase *slot : slots_)
-			delete slot;
-		slots_.clear();
+		for (SlotBase *&slot : slots_) {
+			if (slot)
+				removeSlot(slot);
+		}
+
+		compact();
 	}
 
 	template<typename T>
@@ -203,47 +240,74 @@ public:
 	template<typename T>
 	void disconnect(T *obj, void (T::*func)(Args...))
 	{
-		for (auto iter = slots_.begin(); iter != slots_.end(); ) {
-			SlotArgs<Args...> *slot = static_cast<SlotArgs<Args...> *>(*iter);
+		for (SlotBase *&slot : slots_) {
 			/*
 			 * If the object matches the slot, the slot is
 			 * guaranteed to be a member slot, so we can safely
 			 * cast it to SlotMember<T, Args...> and access its
 			 * func_ member.
 			 */
-			if (slot->match(obj) &&
-			    static_cast<SlotMember<T, Args...> *>(slot)->func_ == func) {
-				iter = slots_.erase(iter);
-				delete slot;
-			} else {
-				++iter;
-			}
+			if (slot && slot->match(obj) &&
+			    static_cast<SlotMember<T, Args...> *>(slot)->func_ == func)
+				removeSlot(slot);
 		}
+
+		compact();
 	}
 
 	void disconnect(void (*func)(Args...))
 	{
-		for (auto iter = slots_.begin(); iter != slots_.end(); ) {
-			SlotArgs<Args...> *slot = *iter;
-			if (slot->match(nullptr) &&
-			    static_cast<SlotStatic<Args...> *>(slot)->func_ == func) {
-				iter = slots_.erase(iter);
-				delete slot;
-			} else {
-				++iter;
-			}
+		for (SlotBase *&slot : slots_) {
+			if (slot && slot->match(nullptr) &&
+			    static_cast<SlotStatic<Args...> *>(slot)->func_ == func)
+				removeSlot(slot);
 		}
+
+		compact();
 	}
 
 	void emit(Args... args)
 	{
 		/*
-		 * Make a copy of the slots list as the slot could call the
-		 * disconnect operation, invalidating the iterator.
+		 * Slots may connect or disconnect slots while the signal is
+		 * being emitted. Index the slots array, as connection may
+		 * reallocate it, and only call the slots connected when the
+		 * emission started. Disconnected slots are set to null and
+		 * removed from the array once the outermost emission
+		 * completes.
+		 */
+		unsigned int count = slots_.size();
+
+		/*
+		 * A slot may also delete the signal, in which case the signal
+		 * members must not be accessed anymore. The destructor flags
+		 * the innermost emission, which propagates the flag to the
+		 * outer ones through the stack.
 		 */
-		std::vector<SlotBase *> slots{ slots_.begin(), slots_.end() };
-		for (SlotBase *slot : slots)
+		bool destroyed = false;
+		bool *outer = destroyed_;
+		destroyed_ = &destroyed;
+
+		emitting_++;
+
+		for (unsigned int i = 0; i < count; ++i) {
+			SlotBase *slot = slots_[i];
+			if (!slot)
+				continue;
+
 			static_cast<SlotArgs<Args...> *>(slot)->activate(args...);
+
+			if (destroyed) {
+				if (outer)
+					*outer = true;
+				return;
+			}
+		}
+
+		emitting_--;
+		destroyed_ = outer;
+
+		compact();
 	}
 };
 
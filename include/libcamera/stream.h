@@ -7,9 +7,13 @@
 #ifndef __LIBCAMERA_STREAM_H__
 #define __LIBCAMERA_STREAM_H__
 
+#include <array>
 #include <map>
 #include <memory>
+#include <stdint.h>
 #include <string>
+#include <sys/types.h>
+#include <utility>
 #include <vector>
 
 #include <libcamera/buffer.h>
@@ -40,6 +44,14 @@ enum MemoryType {
 	ExternalMemory,
 };
 
+struct StreamStatistics {
+	uint64_t frames;
+	uint64_t droppedFrames;
+	uint64_t underrunTime;
+	uint64_t errors;
+	uint64_t cancelled;
+};
+
 struct StreamConfiguration {
 	StreamConfiguration();
 	StreamConfiguration(const StreamFormats &formats);
@@ -49,6 +61,7 @@ struct StreamConfiguration {
 
 	MemoryType memoryType;
 	unsigned int bufferCount;
+	unsigned int maxBufferCount;
 
 	Stream *stream() const { return stream_; }
 	void setStream(Stream *stream) { stream_ = stream; }
@@ -90,13 +103,18 @@ protected:
 
 	void createBuffers(MemoryType memory, unsigned int count);
 	void destroyBuffers();
+	int addBuffers(unsigned int count);
+	void removeBuffers(unsigned int count);
 
 	BufferPool bufferPool_;
 	StreamConfiguration configuration_;
 	MemoryType memoryType_;
 
 private:
-	std::vector<std::pair<std::array<int, 3>, unsigned int>> bufferCache_;
+	using DmabufIdentity = std::array<std::pair<dev_t, ino_t>, 3>;
+
+	std::vector<DmabufIdentity> bufferIdentities_;
+	std::vector<unsigned int> bufferCache_;
 };
 
 } /* namespace libcamera */
@@ -29,8 +29,13 @@ public:
 	Signal<Timer *> timeout;
 
 private:
+	friend class TimerQueue;
+
+	static constexpr unsigned int NotQueued = -1;
+
 	unsigned int interval_;
 	uint64_t deadline_;
+	unsigned int queueIndex_;
 };
 
 } /* namespace libcamera */
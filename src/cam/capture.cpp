@@ -133,7 +133,7 @@ int Capture::capture(EventLoop *loop)
 	return ret;
 }
 
-void Capture::requestComplete(Request *request, const std::map<Stream *, Buffer *> &buffers)
+void Capture::requestComplete(Request *request, const Request::BufferMap &buffers)
 {
 	double fps = 0.0;
 	uint64_t now;
@@ -167,29 +167,10 @@ void Capture::requestComplete(Request *request, const std::map<Stream *, Buffer
 
 	std::cout << info.str() << std::endl;
 
-	/*
-	 * Create a new request and populate it with one buffer for each
-	 * stream.
-	 */
-	request = camera_->createRequest();
-	if (!request) {
-		std::cerr << "Can't create request" << std::endl;
-		return;
-	}
-
-	for (auto it = buffers.begin(); it != buffers.end(); ++it) {
-		Stream *stream = it->first;
-		Buffer *buffer = it->second;
-		unsigned int index = buffer->index();
-
-		std::unique_ptr<Buffer> newBuffer = stream->createBuffer(index);
-		if (!newBuffer) {
-			std::cerr << "Can't create buffer " << index << std::endl;
-			return;
-		}
-
-		request->addBuffer(std::move(newBuffer));
+	/* Requeue the request with the same buffers. */
+	request->reuse();
+	if (camera_->queueRequest(request) < 0) {
+		std::cerr << "Can't queue request" << std::endl;
+		delete request;
 	}
-
-	camera_->queueRequest(request);
 }
@@ -28,7 +28,7 @@ private:
 	int capture(EventLoop *loop);
 
 	void requestComplete(libcamera::Request *request,
-			     const std::map<libcamera::Stream *, libcamera::Buffer *> &buffers);
+			     const libcamera::Request::BufferMap &buffers);
 
 	libcamera::Camera *camera_;
 	libcamera::CameraConfiguration *config_;
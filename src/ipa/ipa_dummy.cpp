@@ -16,6 +16,7 @@ class IPADummy : public IPAInterface
 {
 public:
 	int init();
+	void processEvent(const IPAOperationData &event) {}
 };
 
 int IPADummy::init()
@@ -17,6 +17,7 @@ class IPADummyIsolate : public IPAInterface
 {
 public:
 	int init();
+	void processEvent(const IPAOperationData &event);
 };
 
 int IPADummyIsolate::init()
@@ -25,6 +26,12 @@ int IPADummyIsolate::init()
 	return 0;
 }
 
+void IPADummyIsolate::processEvent(const IPAOperationData &event)
+{
+	/* Echo events back as actions to let tests exercise the proxy. */
+	queueFrameAction.emit(0, event);
+}
+
 /*
  * External IPA module interface
  */
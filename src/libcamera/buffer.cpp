@@ -7,8 +7,11 @@
 
 #include <libcamera/buffer.h>
 
+#include <atomic>
 #include <errno.h>
+#include <linux/dma-buf.h>
 #include <string.h>
+#include <sys/ioctl.h>
 #include <sys/mman.h>
 #include <unistd.h>
 
@@ -23,6 +26,46 @@ namespace libcamera {
 
 LOG_DEFINE_CATEGORY(Buffer)
 
+namespace {
+
+std::atomic<unsigned long> mmapCount(0);
+std::atomic<unsigned long> munmapCount(0);
+
+} /* namespace */
+
+/**
+ * \enum MappingPolicy
+ * \brief Policy for mapping plane memory to the CPU
+ *
+ * Mapping the memory of a plane to the CPU is an expensive operation, and
+ * accessing the mapped memory for the first time incurs page faults. The
+ * mapping policy allows applications to select when, and if, plane memory gets
+ * mapped. Regardless of the policy, mappings are kept for as long as the plane
+ * references the same dmabuf, and are thus reused across frames.
+ *
+ * \var MapOnDemand
+ * Map the memory for read and write access the first time Plane::mem() is
+ * called
+ * \var MapReadOnly
+ * Map the memory for read access only the first time Plane::mem() is called
+ * \var MapPrefault
+ * Map the memory for read and write access as soon as the plane dmabuf is set,
+ * and pre-fault the whole mapping to avoid page faults on first access
+ * \var MapNever
+ * Never map the memory, Plane::mem() always returns nullptr
+ */
+
+/**
+ * \struct MappingStatistics
+ * \brief Plane memory mapping statistics
+ *
+ * \var MappingStatistics::mmaps
+ * \brief The number of memory mappings created
+ *
+ * \var MappingStatistics::munmaps
+ * \brief The number of memory mappings destroyed
+ */
+
 /**
  * \class Plane
  * \brief A memory region to store a single plane of a frame
@@ -46,7 +89,7 @@ LOG_DEFINE_CATEGORY(Buffer)
  */
 
 Plane::Plane()
-	: fd_(-1), length_(0), mem_(0)
+	: fd_(-1), length_(0), mem_(0), policy_(MapOnDemand)
 {
 }
 
@@ -69,7 +112,8 @@ Plane::~Plane()
  * \param[in] length The size of the memory region
  *
  * The \a fd dmabuf file handle is duplicated and stored. The caller may close
- * the original file handle.
+ * the original file handle. Any existing CPU mapping of the previous dmabuf is
+ * released.
  *
  * \return 0 on success or a negative error code otherwise
  */
@@ -80,6 +124,8 @@ int Plane::setDmabuf(int fd, unsigned int length)
 		return -EINVAL;
 	}
 
+	munmap();
+
 	if (fd_ != -1) {
 		close(fd_);
 		fd_ = -1;
@@ -95,18 +141,45 @@ int Plane::setDmabuf(int fd, unsigned int length)
 
 	length_ = length;
 
+	if (policy_ == MapPrefault)
+		mmap();
+
 	return 0;
 }
 
+/**
+ * \brief Set the CPU mapping policy for the plane
+ * \param[in] policy The mapping policy
+ *
+ * Any existing mapping that isn't compatible with the new \a policy is
+ * released. If the \a policy is MapPrefault and the plane has a dmabuf, the
+ * memory is mapped immediately.
+ */
+void Plane::setMappingPolicy(MappingPolicy policy)
+{
+	if (policy == policy_)
+		return;
+
+	if (policy == MapNever || policy == MapReadOnly || policy_ == MapReadOnly)
+		munmap();
+
+	policy_ = policy;
+
+	if (policy_ == MapPrefault && fd_ != -1)
+		mmap();
+}
+
 /**
  * \brief Map the plane memory data to a CPU accessible address
  *
  * The file descriptor to map the memory from must be set by a call to
- * setDmaBuf() before calling this function.
+ * setDmaBuf() before calling this function. The memory is mapped according to
+ * the plane mapping policy.
  *
  * \sa setDmaBuf()
  *
  * \return 0 on success or a negative error code otherwise
+ * \retval -EPERM The mapping policy forbids mapping the memory
  */
 int Plane::mmap()
 {
@@ -115,7 +188,18 @@ int Plane::mmap()
 	if (mem_)
 		return 0;
 
-	map = ::mmap(NULL, length_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+	if (policy_ == MapNever)
+		return -EPERM;
+
+	int prot = PROT_READ;
+	if (policy_ != MapReadOnly)
+		prot |= PROT_WRITE;
+
+	int flags = MAP_SHARED;
+	if (policy_ == MapPrefault)
+		flags |= MAP_POPULATE;
+
+	map = ::mmap(NULL, length_, prot, flags, fd_, 0);
 	if (map == MAP_FAILED) {
 		int ret = -errno;
 		LOG(Buffer, Error)
@@ -124,6 +208,7 @@ int Plane::mmap()
 	}
 
 	mem_ = map;
+	mmapCount.fetch_add(1, std::memory_order_relaxed);
 
 	return 0;
 }
@@ -146,8 +231,9 @@ int Plane::munmap()
 		ret = -errno;
 		LOG(Buffer, Warning)
 			<< "Failed to unmap plane: " << strerror(-ret);
-	} else {
+	} else if (mem_) {
 		mem_ = 0;
+		munmapCount.fetch_add(1, std::memory_order_relaxed);
 	}
 
 	return ret;
@@ -156,6 +242,15 @@ int Plane::munmap()
 /**
  * \fn Plane::mem()
  * \brief Retrieve the CPU accessible memory address of the Plane
+ *
+ * The memory is mapped on first access, unless the plane mapping policy is
+ * MapPrefault in which case it has been mapped when the dmabuf was set, or
+ * MapNever in which case this method always returns nullptr.
+ *
+ * The mapping is cached by the CPU. Accesses to the memory shall be bracketed
+ * by a CpuAccess instance to ensure coherency with devices accessing the memory
+ * through DMA.
+ *
  * \return The CPU accessible memory address on success or nullptr otherwise.
  */
 void *Plane::mem()
@@ -172,6 +267,49 @@ void *Plane::mem()
  * \return The length of the memory region
  */
 
+/**
+ * \brief Synchronize the dmabuf for CPU access
+ * \param[in] flags The DMA_BUF_SYNC_* flags
+ * \return 0 on success or a negative error code otherwise
+ */
+int Plane::sync(uint64_t flags)
+{
+	struct dma_buf_sync sync = {};
+	int ret;
+
+	sync.flags = flags;
+
+	do {
+		ret = ioctl(fd_, DMA_BUF_IOCTL_SYNC, &sync);
+	} while (ret < 0 && (errno == EINTR || errno == EAGAIN));
+
+	if (ret < 0) {
+		ret = -errno;
+		LOG(Buffer, Error)
+			<< "Failed to synchronize dmabuf: " << strerror(-ret);
+		return ret;
+	}
+
+	return 0;
+}
+
+/**
+ * \brief Retrieve the plane memory mapping statistics
+ *
+ * The statistics count the mapping operations performed on all planes since
+ * the library was loaded. They allow verifying that a capture loop doesn't map
+ * or unmap memory in its steady state.
+ *
+ * \return The plane memory mapping statistics
+ */
+MappingStatistics Plane::statistics()
+{
+	MappingStatistics stats;
+	stats.mmaps = mmapCount.load(std::memory_order_relaxed);
+	stats.munmaps = munmapCount.load(std::memory_order_relaxed);
+	return stats;
+}
+
 /**
  * \class BufferMemory
  * \brief A memory buffer to store an image
@@ -187,6 +325,125 @@ void *Plane::mem()
  * \return A reference to a vector holding all Planes within the buffer
  */
 
+/**
+ * \class CpuAccess
+ * \brief Scoped CPU access to plane memory
+ *
+ * Memory shared with devices through dmabuf may be cached by the CPU. To ensure
+ * coherency between CPU and device accesses, CPU accesses to the memory of a
+ * Plane or BufferMemory shall be bracketed by the creation and destruction of
+ * a CpuAccess instance. The constructor synchronizes the memory for CPU access
+ * and the destructor returns it to the devices, for the read and write
+ * directions specified by the access flags.
+ *
+ * \code{.cpp}
+ * {
+ * 	CpuAccess access(buffer->mem(), CpuAccess::Read);
+ * 	if (!access.isValid())
+ * 		return;
+ *
+ * 	for (Plane &plane : buffer->mem()->planes())
+ * 		encode(plane.mem(), plane.length());
+ * }
+ * \endcode
+ *
+ * This allows applications to use cached mappings safely, which are
+ * considerably faster for CPU reads than uncached mappings.
+ */
+
+/**
+ * \enum CpuAccess::Flags
+ * \brief The directions of the CPU access
+ * \var CpuAccess::Read
+ * The CPU reads from the memory
+ * \var CpuAccess::Write
+ * The CPU writes to the memory
+ * \var CpuAccess::ReadWrite
+ * The CPU reads from and writes to the memory
+ */
+
+/**
+ * \brief Start CPU access to a plane
+ * \param[in] plane The plane
+ * \param[in] flags The access directions, as a combination of CpuAccess::Flags
+ */
+CpuAccess::CpuAccess(Plane *plane, unsigned int flags)
+	: plane_(plane), mem_(nullptr), flags_(flags), valid_(false)
+{
+	valid_ = !start(plane_);
+}
+
+/**
+ * \brief Start CPU access to all planes of a buffer memory
+ * \param[in] mem The buffer memory
+ * \param[in] flags The access directions, as a combination of CpuAccess::Flags
+ */
+CpuAccess::CpuAccess(BufferMemory *mem, unsigned int flags)
+	: plane_(nullptr), mem_(mem), flags_(flags), valid_(false)
+{
+	std::vector<Plane> &planes = mem_->planes();
+
+	for (auto it = planes.begin(); it != planes.end(); ++it) {
+		if (start(&*it) < 0) {
+			/* Release the planes that have been synchronized. */
+			while (it != planes.begin())
+				end(&*--it);
+			return;
+		}
+	}
+
+	valid_ = true;
+}
+
+/**
+ * \brief End CPU access, returning the memory to devices
+ */
+CpuAccess::~CpuAccess()
+{
+	if (!valid_)
+		return;
+
+	if (plane_) {
+		end(plane_);
+		return;
+	}
+
+	for (Plane &plane : mem_->planes())
+		end(&plane);
+}
+
+/**
+ * \fn CpuAccess::isValid()
+ * \brief Check if CPU access has been granted
+ *
+ * CPU access may fail if the memory isn't backed by a dmabuf. The memory shall
+ * not be accessed by the CPU in that case.
+ *
+ * \return True if the CPU access has been granted, false otherwise
+ */
+
+int CpuAccess::start(Plane *plane)
+{
+	return plane->sync(DMA_BUF_SYNC_START | syncDirection());
+}
+
+void CpuAccess::end(Plane *plane)
+{
+	plane->sync(DMA_BUF_SYNC_END | syncDirection());
+}
+
+uint64_t CpuAccess::syncDirection() const
+{
+	uint64_t flags = 0;
+
+	if (flags_ & Read)
+		flags |= DMA_BUF_SYNC_READ;
+	if (flags_ & Write)
+		flags |= DMA_BUF_SYNC_WRITE;
+
+	return flags;
+}
+
 /**
  * \class BufferPool
  * \brief A pool of buffers
@@ -194,8 +451,20 @@ void *Plane::mem()
  * The BufferPool class groups together a collection of Buffers to store frames.
  * The buffers must be exported by a device before they can be imported into
  * another device for further use.
+ *
+ * The pool stores a mapping policy that controls how the memory of the planes
+ * of all its buffers is mapped to the CPU.
+ *
+ * A pool can be made persistent to keep its buffers memory allocated across
+ * reconfigurations of the devices and streams it is used with, see
+ * setPersistent().
  */
 
+BufferPool::BufferPool()
+	: policy_(MapOnDemand), persistent_(false)
+{
+}
+
 BufferPool::~BufferPool()
 {
 	destroyBuffers();
@@ -233,6 +502,57 @@ void BufferPool::destroyBuffers()
  * \return A vector containing all the buffers in the pool.
  */
 
+/**
+ * \fn BufferPool::mappingPolicy()
+ * \brief Retrieve the CPU mapping policy for the pool buffers
+ * \return The mapping policy
+ */
+
+/**
+ * \brief Set the CPU mapping policy for the pool buffers
+ * \param[in] policy The mapping policy
+ *
+ * The \a policy is applied to the planes of all buffers in the pool, and to the
+ * planes later added to the pool's buffers by the video device exporting the
+ * buffers or by the stream importing external buffers.
+ */
+void BufferPool::setMappingPolicy(MappingPolicy policy)
+{
+	policy_ = policy;
+
+	for (BufferMemory &buffer : buffers_) {
+		for (Plane &plane : buffer.planes())
+			plane.setMappingPolicy(policy);
+	}
+}
+
+/**
+ * \fn BufferPool::persistent()
+ * \brief Check if the pool is persistent
+ * \return True if the pool is persistent, false otherwise
+ */
+
+/**
+ * \fn BufferPool::setPersistent()
+ * \brief Set whether the pool is persistent
+ * \param[in] persistent True to make the pool persistent
+ *
+ * The buffers of a persistent pool keep their memory when the camera is
+ * reconfigured or its buffers freed. Memory is allocated by the video device
+ * exporting the buffers for the largest format the pool has been used with,
+ * and reused without reallocation by all configurations with the same number
+ * of buffers, or fewer, whose frames fit in the buffers.
+ *
+ * Applications that switch between different stream configurations, such as
+ * a viewfinder and a still capture resolution, should make the stream pool
+ * persistent after configuring the camera for the largest resolution, to
+ * avoid reallocating buffers at every switch.
+ *
+ * Persistence only applies to pools of streams using InternalMemory. The
+ * memory of a persistent pool is released when the pool is destroyed, or when
+ * the stream is reconfigured after the pool has been made non-persistent.
+ */
+
 /**
  * \class Buffer
  * \brief A buffer handle and dynamic metadata
@@ -271,7 +591,7 @@ void BufferPool::destroyBuffers()
 Buffer::Buffer(unsigned int index, const Buffer *metadata)
 	: index_(index), dmabuf_({ -1, -1, -1 }),
 	  status_(Buffer::BufferSuccess), request_(nullptr),
-	  stream_(nullptr)
+	  stream_(nullptr), traced_(false), traceQueued_(0), traceDequeued_(0)
 {
 	if (metadata) {
 		bytesused_ = metadata->bytesused_;
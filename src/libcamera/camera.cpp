@@ -12,6 +12,7 @@
 #include <libcamera/request.h>
 #include <libcamera/stream.h>
 
+#include "latency_histogram.h"
 #include "log.h"
 #include "pipeline_handler.h"
 #include "utils.h"
@@ -253,6 +254,49 @@ std::size_t CameraConfiguration::size() const
  * \brief The vector of stream configurations
  */
 
+/**
+ * \enum LatencyStage
+ * \brief The stages of request processing whose latency is traced
+ *
+ * Each stage spans the interval between two request trace points, see
+ * Request::TracePoint.
+ *
+ * \var LatencyCamera
+ * From queueing the request to the camera to passing it to the pipeline
+ * handler
+ * \var LatencyPipeline
+ * From passing the request to the pipeline handler to queueing its first
+ * buffer to a video device
+ * \var LatencyDevice
+ * From queueing the first buffer to a video device to dequeuing the last
+ * buffer
+ * \var LatencyCompletion
+ * From dequeuing the last buffer to signalling the request completion
+ * \var LatencyTotal
+ * From queueing the request to the camera to signalling its completion
+ * \var LatencyStageCount
+ * The number of latency stages
+ */
+
+/**
+ * \struct LatencyStatistics
+ * \brief Latency statistics of a request processing stage
+ *
+ * All latencies are expressed in nanoseconds.
+ *
+ * \var LatencyStatistics::count
+ * \brief The number of latency samples
+ *
+ * \var LatencyStatistics::p50
+ * \brief The median latency
+ *
+ * \var LatencyStatistics::p99
+ * \brief The 99th percentile latency
+ *
+ * \var LatencyStatistics::max
+ * \brief The maximum latency
+ */
+
 /**
  * \class Camera
  * \brief Camera device
@@ -310,11 +354,11 @@ std::size_t CameraConfiguration::size() const
  *   Configured -> Prepared [label = "allocateBuffers()"];
  *
  *   Prepared -> Configured [label = "freeBuffers()"];
- *   Prepared -> Prepared [label = "createRequest()"];
+ *   Prepared -> Prepared [label = "createRequest(), addBuffers()"];
  *   Prepared -> Running [label = "start()"];
  *
  *   Running -> Prepared [label = "stop()"];
- *   Running -> Running [label = "createRequest(), queueRequest()"];
+ *   Running -> Running [label = "createRequest(), queueRequest(), addBuffers()"];
  * }
  * \enddot
  *
@@ -404,8 +448,9 @@ const std::string &Camera::name() const
  */
 
 Camera::Camera(PipelineHandler *pipe, const std::string &name)
-	: pipe_(pipe->shared_from_this()), name_(name), disconnected_(false),
-	  state_(CameraAvailable)
+	: pipe_(pipe->shared_from_this()), name_(name),
+	  completedRequest_(nullptr), disconnected_(false),
+	  state_(CameraAvailable), tracing_(false)
 {
 }
 
@@ -413,6 +458,9 @@ Camera::~Camera()
 {
 	if (!stateIs(CameraAvailable))
 		LOG(Camera, Error) << "Removing camera while still in use";
+
+	for (Request *request : requestPool_)
+		delete request;
 }
 
 static const char *const camera_state_names[] = {
@@ -574,6 +622,26 @@ const std::set<Stream *> &Camera::streams() const
 	return streams_;
 }
 
+/**
+ * \brief Retrieve the frame delivery statistics of the camera streams
+ *
+ * The statistics count, for each stream of the camera, the frames captured,
+ * dropped, or completed in error, the buffers cancelled when stopping the
+ * camera, and the time spent streaming without any buffer available. They are
+ * accumulated from the creation of the camera, and can be retrieved at any
+ * time, including while the camera is running.
+ *
+ * Frames dropped while the stream is starved of buffers are caused by the
+ * application not queuing requests fast enough, while frames dropped or
+ * completed in error otherwise point to the device.
+ *
+ * \return A map of all the camera's streams to their statistics
+ */
+std::map<Stream *, StreamStatistics> Camera::statistics()
+{
+	return pipe_->statistics(this);
+}
+
 /**
  * \brief Generate a default camera configuration according to stream roles
  * \param[in] roles A list of stream roles
@@ -742,7 +810,8 @@ int Camera::freeBuffers()
 	for (Stream *stream : activeStreams_) {
 		/*
 		 * All mappings must be destroyed before buffers can be freed
-		 * by the V4L2 device that has allocated them.
+		 * by the V4L2 device that has allocated them. Persistent pools
+		 * keep their buffers, whose memory isn't owned by the device.
 		 */
 		stream->destroyBuffers();
 	}
@@ -752,6 +821,56 @@ int Camera::freeBuffers()
 	return pipe_->freeBuffers(this, activeStreams_);
 }
 
+/**
+ * \brief Add buffers to a stream at runtime
+ * \param[in] stream The stream to add buffers to
+ * \param[in] count The number of buffers to add
+ *
+ * This method grows the number of buffers of an active \a stream by \a count,
+ * up to the StreamConfiguration::maxBufferCount set when configuring the
+ * camera. It allows applications to absorb load spikes without stopping the
+ * camera, when consumers hold on to captured buffers for longer than usual.
+ *
+ * The new buffers are indexed after the existing buffers of the stream. They
+ * remain allocated until the camera buffers are freed with freeBuffers().
+ *
+ * This function shall only be called when the camera is in the Prepared or
+ * Running state, see \ref camera_operation.
+ *
+ * \return 0 on success or a negative error code otherwise
+ * \retval -ENODEV The camera has been disconnected from the system
+ * \retval -EACCES The camera is not in a state where buffers can be added
+ * \retval -EINVAL The stream is not active
+ * \retval -ENOSPC The stream would exceed its maximum number of buffers
+ * \retval -ENOTSUP The pipeline handler doesn't support adding buffers
+ */
+int Camera::addBuffers(Stream *stream, unsigned int count)
+{
+	if (disconnected_)
+		return -ENODEV;
+
+	if (!stateBetween(CameraPrepared, CameraRunning))
+		return -EACCES;
+
+	if (activeStreams_.find(stream) == activeStreams_.end()) {
+		LOG(Camera, Error) << "Can't add buffers to inactive stream";
+		return -EINVAL;
+	}
+
+	int ret = stream->addBuffers(count);
+	if (ret)
+		return ret;
+
+	ret = pipe_->addBuffers(this, stream, count);
+	if (ret) {
+		LOG(Camera, Error) << "Failed to add buffers";
+		stream->removeBuffers(count);
+		return ret;
+	}
+
+	return 0;
+}
+
 /**
  * \brief Create a request object for the camera
  * \param[in] cookie Opaque cookie for application use
@@ -767,6 +886,11 @@ int Camera::freeBuffers()
  * The ownership of the returned request is passed to the caller, which is
  * responsible for either queueing the request or deleting it.
  *
+ * Requests are recycled from a per-camera pool of completed requests when
+ * possible, to avoid memory allocation at every frame. Applications that
+ * requeue the same buffers continuously should however reuse completed
+ * requests with Request::reuse() instead of creating new ones.
+ *
  * This function shall only be called when the camera is in the Prepared
  * or Running state, see \ref camera_operation.
  *
@@ -777,7 +901,15 @@ Request *Camera::createRequest(uint64_t cookie)
 	if (disconnected_ || !stateBetween(CameraPrepared, CameraRunning))
 		return nullptr;
 
-	return new Request(this, cookie);
+	if (requestPool_.empty())
+		return new Request(this, cookie);
+
+	Request *request = requestPool_.back();
+	requestPool_.pop_back();
+	request->reset();
+	request->cookie_ = cookie;
+
+	return request;
 }
 
 /**
@@ -794,7 +926,8 @@ Request *Camera::createRequest(uint64_t cookie)
  * through the \ref requestCompleted signal.
  *
  * Ownership of the request is transferred to the camera. It will be deleted
- * automatically after it completes.
+ * automatically after it completes, unless the application reuses it with
+ * Request::reuse() from the completion handler.
  *
  * \return 0 on success or a negative error code otherwise
  * \retval -ENODEV The camera has been disconnected from the system
@@ -810,6 +943,11 @@ int Camera::queueRequest(Request *request)
 	if (!stateIs(CameraRunning))
 		return -EACCES;
 
+	if (tracing_) {
+		request->trace_.fill(0);
+		request->trace_[Request::TraceQueued] = utils::clock_monotonic();
+	}
+
 	for (auto const &it : request->buffers()) {
 		Stream *stream = it.first;
 		Buffer *buffer = it.second;
@@ -830,6 +968,7 @@ int Camera::queueRequest(Request *request)
 		}
 
 		buffer->mem_ = &stream->buffers()[buffer->index_];
+		buffer->traced_ = tracing_;
 	}
 
 	int ret = request->prepare();
@@ -838,6 +977,9 @@ int Camera::queueRequest(Request *request)
 		return ret;
 	}
 
+	if (tracing_)
+		request->trace_[Request::TracePipelineQueued] = utils::clock_monotonic();
+
 	return pipe_->queueRequest(this, request);
 }
 
@@ -902,13 +1044,94 @@ int Camera::stop()
 	return 0;
 }
 
+/**
+ * \brief Enable or disable request latency tracing
+ * \param[in] enable True to enable tracing, false to disable it
+ *
+ * When tracing is enabled, requests queued to the camera are timestamped at
+ * each stage of their processing, as reported by Request::traceTimestamp(),
+ * and the latencies of the stages of completed requests are aggregated in
+ * histograms that can be retrieved with latency(). Enabling tracing resets the
+ * histograms. When tracing is disabled, requests are not timestamped.
+ *
+ * Tracing affects the requests queued after this method is called.
+ */
+void Camera::setTracing(bool enable)
+{
+	tracing_ = enable;
+
+	if (!enable)
+		return;
+
+	if (!latency_)
+		latency_.reset(new LatencyHistogram[LatencyStageCount]);
+
+	for (unsigned int i = 0; i < LatencyStageCount; ++i)
+		latency_[i].reset();
+}
+
+/**
+ * \brief Retrieve the latency statistics of a request processing stage
+ * \param[in] stage The processing stage
+ *
+ * The statistics are computed from all requests completed successfully since
+ * tracing has been enabled with setTracing(). Requests whose pipeline handler
+ * doesn't report the stage's trace points are not accounted for. Percentiles
+ * are approximated with a relative error lower than 12.5%.
+ *
+ * \return The latency statistics, in nanoseconds
+ */
+LatencyStatistics Camera::latency(LatencyStage stage) const
+{
+	if (!latency_ || stage >= LatencyStageCount)
+		return {};
+
+	return latency_[stage].statistics();
+}
+
+/*
+ * Record the completion time of a request and the latencies of its processing
+ * stages. Cancelled requests are ignored as their latencies are meaningless.
+ */
+void Camera::traceRequest(Request *request)
+{
+	static const struct {
+		Request::TracePoint start;
+		Request::TracePoint end;
+	} stages[LatencyStageCount] = {
+		{ Request::TraceQueued, Request::TracePipelineQueued },
+		{ Request::TracePipelineQueued, Request::TraceDeviceQueued },
+		{ Request::TraceDeviceQueued, Request::TraceDeviceDequeued },
+		{ Request::TraceDeviceDequeued, Request::TraceCompleted },
+		{ Request::TraceQueued, Request::TraceCompleted },
+	};
+
+	request->trace_[Request::TraceCompleted] = utils::clock_monotonic();
+
+	if (request->status() != Request::RequestComplete)
+		return;
+
+	for (unsigned int i = 0; i < LatencyStageCount; ++i) {
+		uint64_t start = request->trace_[stages[i].start];
+		uint64_t end = request->trace_[stages[i].end];
+
+		if (start && end >= start)
+			latency_[i].record(end - start);
+	}
+}
+
 /**
  * \brief Handle request completion and notify application
  * \param[in] request The request that has completed
  *
  * This function is called by the pipeline handler to notify the camera that
- * the request has completed. It emits the requestCompleted signal and deletes
- * the request.
+ * the request has completed. It emits the requestCompleted signal and, unless
+ * the application has reused the request, returns it to the camera's pool of
+ * requests.
+ *
+ * A reused request belongs to the application, which may delete it from the
+ * signal handler. The request is thus not accessed after the signal is
+ * emitted, requests returned to the pool are reset when they get recycled.
  */
 void Camera::requestComplete(Request *request)
 {
@@ -919,8 +1142,16 @@ void Camera::requestComplete(Request *request)
 			stream->unmapBuffer(buffer);
 	}
 
+	if (tracing_)
+		traceRequest(request);
+
+	completedRequest_ = request;
+
 	requestCompleted.emit(request, request->buffers());
-	delete request;
+
+	if (completedRequest_)
+		requestPool_.push_back(completedRequest_);
+	completedRequest_ = nullptr;
 }
 
 } /* namespace libcamera */
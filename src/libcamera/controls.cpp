@@ -12,6 +12,7 @@
 
 #include <libcamera/camera.h>
 
+#include "controls_internal.h"
 #include "log.h"
 #include "utils.h"
 
@@ -20,6 +21,11 @@
  * \brief Describes control framework and controls supported by a camera
  */
 
+/**
+ * \file controls_internal.h
+ * \brief Access to the controls known to libcamera, for internal use
+ */
+
 namespace libcamera {
 
 LOG_DEFINE_CATEGORY(Controls)
@@ -248,8 +254,8 @@ std::string ControlValue::toString() const
  * The controlTypes are automatically generated to produce a control_types.cpp
  * output. This file is not for public use, and so no suitable header exists
  * for this sole usage of the controlTypes reference. As such the extern is
- * only defined here for use during the ControlInfo constructor and should not
- * be referenced directly elsewhere.
+ * only defined here and should not be referenced directly elsewhere. Use
+ * controlIdentifier() and knownControls() instead.
  */
 extern const std::unordered_map<ControlId, ControlIdentifier> controlTypes;
 
@@ -273,13 +279,9 @@ ControlInfo::ControlInfo(ControlId id, const ControlValue &min,
 			 const ControlValue &max)
 	: min_(min), max_(max)
 {
-	auto iter = controlTypes.find(id);
-	if (iter == controlTypes.end()) {
+	ident_ = controlIdentifier(id);
+	if (!ident_)
 		LOG(Controls, Fatal) << "Attempt to create invalid ControlInfo";
-		return;
-	}
-
-	ident_ = &iter->second;
 }
 
 /**
@@ -374,6 +376,43 @@ bool operator==(const ControlInfo &lhs, const ControlId &rhs)
  * \brief A map of ControlId to ControlInfo
  */
 
+/**
+ * \brief Retrieve the identifier of a control
+ * \param[in] id The control ID
+ * \return The identifier of the control \a id, or nullptr if \a id isn't a
+ * control known to libcamera
+ */
+const ControlIdentifier *controlIdentifier(ControlId id)
+{
+	auto iter = controlTypes.find(id);
+	if (iter == controlTypes.end())
+		return nullptr;
+
+	return &iter->second;
+}
+
+/**
+ * \brief Retrieve information about all the controls known to libcamera
+ *
+ * The returned map contains one ControlInfo for each control known to
+ * libcamera, without any limit on the control values. It is meant for code
+ * that handles controls without access to a Camera, such as IPA modules and
+ * their proxies. The map is created on the first call to this function.
+ *
+ * \return A map of all controls known to libcamera
+ */
+const ControlInfoMap &knownControls()
+{
+	static const ControlInfoMap controls = []() {
+		ControlInfoMap map;
+		for (const auto &type : controlTypes)
+			map.emplace(type.first, ControlInfo(type.first));
+		return map;
+	}();
+
+	return controls;
+}
+
 /**
  * \class ControlList
  * \brief Associate a list of ControlId with their values for a camera
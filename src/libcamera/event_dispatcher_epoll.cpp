@@ -0,0 +1,296 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * event_dispatcher_epoll.cpp - Epoll-based event dispatcher
+ */
+
+#include "event_dispatcher_epoll.h"
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <libcamera/event_notifier.h>
+#include <libcamera/timer.h>
+
+#include "log.h"
+#include "trace.h"
+
+/**
+ * \file event_dispatcher_epoll.h
+ */
+
+namespace libcamera {
+
+LOG_DECLARE_CATEGORY(Event)
+
+/**
+ * \class EventDispatcherEpoll
+ * \brief An epoll-based event dispatcher
+ *
+ * The EventDispatcherEpoll keeps the set of monitored file descriptors in the
+ * kernel, and only updates it when event notifiers are registered or
+ * unregistered. Unlike the EventDispatcherPoll, the cost of waiting for events
+ * thus depends on the number of file descriptors that are ready, not on the
+ * number of file descriptors being monitored.
+ */
+
+EventDispatcherEpoll::EventDispatcherEpoll()
+	: processingEvents_(false)
+{
+	/*
+	 * Create the epoll and event fds. Failures are fatal as we can't
+	 * implement an interruptible dispatcher without them.
+	 */
+	epollfd_ = epoll_create1(EPOLL_CLOEXEC);
+	if (epollfd_ < 0)
+		LOG(Event, Fatal) << "Unable to create epoll fd";
+
+	eventfd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	if (eventfd_ < 0)
+		LOG(Event, Fatal) << "Unable to create eventfd";
+
+	/*
+	 * The interrupt eventfd is identified by a null data pointer, and the
+	 * timer queue fd by a pointer to the timer queue.
+	 */
+	struct epoll_event event = {};
+	event.events = EPOLLIN;
+	event.data.ptr = nullptr;
+
+	if (epoll_ctl(epollfd_, EPOLL_CTL_ADD, eventfd_, &event) < 0)
+		LOG(Event, Fatal) << "Unable to monitor eventfd";
+
+	event.data.ptr = &timers_;
+
+	if (epoll_ctl(epollfd_, EPOLL_CTL_ADD, timers_.fd(), &event) < 0)
+		LOG(Event, Fatal) << "Unable to monitor timerfd";
+
+	staleNotifiers_.reserve(MaxEvents);
+}
+
+EventDispatcherEpoll::~EventDispatcherEpoll()
+{
+	close(eventfd_);
+	close(epollfd_);
+}
+
+void EventDispatcherEpoll::registerEventNotifier(EventNotifier *notifier)
+{
+	EventNotifierSetEpoll &set = notifiers_[notifier->fd()];
+	EventNotifier::Type type = notifier->type();
+
+	if (set.notifiers[type] && set.notifiers[type] != notifier) {
+		LOG(Event, Warning)
+			<< "Ignoring duplicate notifier for fd " << notifier->fd();
+		return;
+	}
+
+	set.notifiers[type] = notifier;
+
+	update(notifier->fd(), &set);
+}
+
+void EventDispatcherEpoll::unregisterEventNotifier(EventNotifier *notifier)
+{
+	auto iter = notifiers_.find(notifier->fd());
+	if (iter == notifiers_.end())
+		return;
+
+	EventNotifierSetEpoll &set = iter->second;
+	EventNotifier::Type type = notifier->type();
+
+	if (!set.notifiers[type])
+		return;
+
+	if (set.notifiers[type] != notifier) {
+		LOG(Event, Warning)
+			<< "Notifier for fd " << notifier->fd()
+			<< " is not registered";
+		return;
+	}
+
+	set.notifiers[type] = nullptr;
+
+	update(notifier->fd(), &set);
+
+	if (set.registered)
+		return;
+
+	/*
+	 * Events returned by the current epoll_wait() call reference the set,
+	 * don't free it if this method is called from an event notifier. The
+	 * notifiers_ entry will be erased by processEvents().
+	 */
+	if (processingEvents_) {
+		staleNotifiers_.push_back(notifier->fd());
+		return;
+	}
+
+	notifiers_.erase(iter);
+}
+
+void EventDispatcherEpoll::registerTimer(Timer *timer)
+{
+	timers_.add(timer);
+}
+
+void EventDispatcherEpoll::unregisterTimer(Timer *timer)
+{
+	timers_.remove(timer);
+}
+
+void EventDispatcherEpoll::processEvents()
+{
+	struct epoll_event events[MaxEvents];
+	bool timersExpired = false;
+	int ret;
+
+	/*
+	 * Wait for events and process notifiers and timers. Timer expiration
+	 * is signalled through the timer queue fd, there's thus no need for a
+	 * timeout.
+	 */
+	do {
+		ret = epoll_wait(epollfd_, events, MaxEvents, -1);
+	} while (ret == -1 && errno == EINTR);
+
+	if (ret < 0) {
+		ret = -errno;
+		LOG(Event, Warning)
+			<< "epoll_wait() failed with " << strerror(-ret);
+	}
+
+	TRACE_SCOPE(Event, "EventDispatcherEpoll::processEvents");
+
+	processingEvents_ = true;
+
+	for (int i = 0; i < ret; ++i) {
+		void *data = events[i].data.ptr;
+
+		if (!data)
+			processInterrupt();
+		else if (data == &timers_)
+			timersExpired = true;
+		else
+			processNotifier(static_cast<EventNotifierSetEpoll *>(data),
+					events[i].events);
+	}
+
+	processingEvents_ = false;
+
+	/* Erase the notifiers_ entries that have been emptied. */
+	for (int fd : staleNotifiers_) {
+		auto iter = notifiers_.find(fd);
+		if (iter != notifiers_.end() && !iter->second.registered)
+			notifiers_.erase(iter);
+	}
+
+	staleNotifiers_.clear();
+
+	if (timersExpired)
+		timers_.process();
+}
+
+void EventDispatcherEpoll::interrupt()
+{
+	uint64_t value = 1;
+	ssize_t ret = write(eventfd_, &value, sizeof(value));
+	if (ret != sizeof(value)) {
+		if (ret < 0)
+			ret = -errno;
+		LOG(Event, Error)
+			<< "Failed to interrupt event dispatcher ("
+			<< ret << ")";
+	}
+}
+
+uint32_t EventDispatcherEpoll::EventNotifierSetEpoll::events() const
+{
+	uint32_t events = 0;
+
+	if (notifiers[EventNotifier::Read])
+		events |= EPOLLIN;
+	if (notifiers[EventNotifier::Write])
+		events |= EPOLLOUT;
+	if (notifiers[EventNotifier::Exception])
+		events |= EPOLLPRI;
+
+	return events;
+}
+
+int EventDispatcherEpoll::update(int fd, EventNotifierSetEpoll *set)
+{
+	struct epoll_event event = {};
+	int op;
+
+	event.events = set->events();
+	event.data.ptr = set;
+
+	if (!event.events)
+		op = EPOLL_CTL_DEL;
+	else if (set->registered)
+		op = EPOLL_CTL_MOD;
+	else
+		op = EPOLL_CTL_ADD;
+
+	int ret = epoll_ctl(epollfd_, op, fd, &event);
+	if (ret < 0) {
+		ret = -errno;
+		LOG(Event, Error)
+			<< "Failed to update epoll set for fd " << fd << ": "
+			<< strerror(-ret);
+	}
+
+	/*
+	 * Closing a file descriptor removes it from the epoll set, so a
+	 * failure to remove it still leaves it unregistered.
+	 */
+	if (op == EPOLL_CTL_DEL)
+		set->registered = false;
+	else if (!ret)
+		set->registered = true;
+
+	return ret;
+}
+
+void EventDispatcherEpoll::processInterrupt()
+{
+	uint64_t value;
+	ssize_t ret = read(eventfd_, &value, sizeof(value));
+	if (ret != sizeof(value)) {
+		if (ret < 0)
+			ret = -errno;
+		LOG(Event, Error)
+			<< "Failed to process interrupt (" << ret << ")";
+	}
+}
+
+void EventDispatcherEpoll::processNotifier(EventNotifierSetEpoll *set,
+					   uint32_t events)
+{
+	static const struct {
+		EventNotifier::Type type;
+		uint32_t events;
+	} types[] = {
+		{ EventNotifier::Read, EPOLLIN },
+		{ EventNotifier::Write, EPOLLOUT },
+		{ EventNotifier::Exception, EPOLLPRI },
+	};
+
+	for (const auto &type : types) {
+		/*
+		 * The notifier may have been unregistered by a previous
+		 * notifier's handler, check it for every type.
+		 */
+		EventNotifier *notifier = set->notifiers[type.type];
+		if (notifier && events & type.events)
+			notifier->activated.emit(notifier);
+	}
+}
+
+} /* namespace libcamera */
@@ -0,0 +1,136 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * frame_statistics.cpp - Frame delivery statistics tracking
+ */
+
+#include "frame_statistics.h"
+
+#include <libcamera/stream.h>
+
+#include "utils.h"
+
+/**
+ * \file frame_statistics.h
+ * \brief Frame delivery statistics tracking
+ */
+
+namespace libcamera {
+
+/**
+ * \class FrameStatistics
+ * \brief Accumulate the frame delivery statistics of a video device
+ *
+ * The FrameStatistics class is fed with the events of a capture session, stream
+ * on and off, frame completion and buffer starvation, and accumulates them in
+ * the counters reported through StreamStatistics. It doesn't access the device,
+ * and the clock is only read when an underrun starts or stops.
+ */
+
+FrameStatistics::FrameStatistics()
+	: streaming_(false), nextSequence_(0), underrunStart_(0), frames_(0),
+	  droppedFrames_(0), underrunTime_(0), errors_(0), cancelled_(0)
+{
+}
+
+/**
+ * \brief Start a capture session
+ * \param[in] underrun True if no buffer is queued to the device
+ *
+ * The frame sequence numbers are reset, as devices number frames from stream
+ * on.
+ */
+void FrameStatistics::start(bool underrun)
+{
+	streaming_ = true;
+	nextSequence_ = 0;
+
+	if (underrun)
+		startUnderrun();
+}
+
+/**
+ * \brief Stop a capture session
+ * \param[in] cancelled The number of buffers cancelled by the device
+ */
+void FrameStatistics::stop(unsigned int cancelled)
+{
+	stopUnderrun();
+	streaming_ = false;
+
+	cancelled_ += cancelled;
+}
+
+/**
+ * \brief Record that the device ran out of buffers
+ *
+ * The underrun starts when the last queued buffer is dequeued, and is ignored
+ * when the device isn't streaming.
+ */
+void FrameStatistics::startUnderrun()
+{
+	if (!streaming_)
+		return;
+
+	underrunStart_ = utils::clock_monotonic();
+}
+
+/**
+ * \brief Record that a buffer has been queued to the device
+ *
+ * The time elapsed since the start of the underrun, if any, is added to the
+ * underrun time.
+ */
+void FrameStatistics::stopUnderrun()
+{
+	if (!underrunStart_)
+		return;
+
+	underrunTime_ += utils::clock_monotonic() - underrunStart_;
+	underrunStart_ = 0;
+}
+
+/**
+ * \brief Record the completion of a frame
+ * \param[in] error True if the frame has been completed with an error
+ */
+void FrameStatistics::frameCompleted(bool error)
+{
+	frames_++;
+	if (error)
+		errors_++;
+}
+
+/**
+ * \brief Record the sequence number of a completed frame
+ * \param[in] sequence The frame sequence number
+ *
+ * Capture devices number all frames they capture from stream on, including the
+ * ones they drop when no buffer is available. Gaps in the sequence numbers are
+ * counted as dropped frames.
+ */
+void FrameStatistics::frameSequence(uint32_t sequence)
+{
+	if (sequence > nextSequence_)
+		droppedFrames_ += sequence - nextSequence_;
+	nextSequence_ = sequence + 1;
+}
+
+/**
+ * \brief Retrieve the accumulated statistics
+ * \return The frame delivery statistics
+ */
+StreamStatistics FrameStatistics::statistics() const
+{
+	StreamStatistics stats;
+	stats.frames = frames_;
+	stats.droppedFrames = droppedFrames_;
+	stats.underrunTime = underrunTime_;
+	stats.errors = errors_;
+	stats.cancelled = cancelled_;
+
+	return stats;
+}
+
+} /* namespace libcamera */
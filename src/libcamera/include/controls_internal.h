@@ -0,0 +1,19 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * controls_internal.h - Internal control handling helpers
+ */
+#ifndef __LIBCAMERA_CONTROLS_INTERNAL_H__
+#define __LIBCAMERA_CONTROLS_INTERNAL_H__
+
+#include <libcamera/controls.h>
+
+namespace libcamera {
+
+const ControlIdentifier *controlIdentifier(ControlId id);
+const ControlInfoMap &knownControls();
+
+} /* namespace libcamera */
+
+#endif /* __LIBCAMERA_CONTROLS_INTERNAL_H__ */
@@ -0,0 +1,64 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * event_dispatcher_epoll.h - Epoll-based event dispatcher
+ */
+#ifndef __LIBCAMERA_EVENT_DISPATCHER_EPOLL_H__
+#define __LIBCAMERA_EVENT_DISPATCHER_EPOLL_H__
+
+#include <libcamera/event_dispatcher.h>
+
+#include <map>
+#include <stdint.h>
+#include <vector>
+
+#include "timer_queue.h"
+
+struct epoll_event;
+
+namespace libcamera {
+
+class EventNotifier;
+class Timer;
+
+class EventDispatcherEpoll final : public EventDispatcher
+{
+public:
+	EventDispatcherEpoll();
+	~EventDispatcherEpoll();
+
+	void registerEventNotifier(EventNotifier *notifier);
+	void unregisterEventNotifier(EventNotifier *notifier);
+
+	void registerTimer(Timer *timer);
+	void unregisterTimer(Timer *timer);
+
+	void processEvents();
+	void interrupt();
+
+private:
+	struct EventNotifierSetEpoll {
+		uint32_t events() const;
+		EventNotifier *notifiers[3];
+		bool registered;
+	};
+
+	static constexpr unsigned int MaxEvents = 16;
+
+	std::map<int, EventNotifierSetEpoll> notifiers_;
+	std::vector<int> staleNotifiers_;
+	TimerQueue timers_;
+	int epollfd_;
+	int eventfd_;
+
+	bool processingEvents_;
+
+	int update(int fd, EventNotifierSetEpoll *set);
+	void processInterrupt();
+	void processNotifier(EventNotifierSetEpoll *set, uint32_t events);
+};
+
+} /* namespace libcamera */
+
+#endif /* __LIBCAMERA_EVENT_DISPATCHER_EPOLL_H__ */
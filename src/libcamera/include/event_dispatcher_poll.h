@@ -9,11 +9,11 @@
 
 #include <libcamera/event_dispatcher.h>
 
-#include <list>
 #include <map>
+#include <poll.h>
 #include <vector>
 
-struct pollfd;
+#include "timer_queue.h"
 
 namespace libcamera {
 
@@ -42,15 +42,15 @@ private:
 	};
 
 	std::map<int, EventNotifierSetPoll> notifiers_;
-	std::list<Timer *> timers_;
+	std::vector<struct pollfd> pollfds_;
+	TimerQueue timers_;
 	int eventfd_;
 
 	bool processingEvents_;
 
-	int poll(std::vector<struct pollfd> *pollfds);
 	void processInterrupt(const struct pollfd &pfd);
 	void processNotifiers(const std::vector<struct pollfd> &pollfds);
-	void processTimers();
+	void processTimers(const struct pollfd &pfd);
 };
 
 } /* namespace libcamera */
@@ -0,0 +1,46 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * frame_statistics.h - Frame delivery statistics tracking
+ */
+#ifndef __LIBCAMERA_FRAME_STATISTICS_H__
+#define __LIBCAMERA_FRAME_STATISTICS_H__
+
+#include <stdint.h>
+
+namespace libcamera {
+
+struct StreamStatistics;
+
+class FrameStatistics
+{
+public:
+	FrameStatistics();
+
+	void start(bool underrun);
+	void stop(unsigned int cancelled);
+
+	void startUnderrun();
+	void stopUnderrun();
+
+	void frameCompleted(bool error);
+	void frameSequence(uint32_t sequence);
+
+	StreamStatistics statistics() const;
+
+private:
+	bool streaming_;
+	uint32_t nextSequence_;
+	uint64_t underrunStart_;
+
+	uint64_t frames_;
+	uint64_t droppedFrames_;
+	uint64_t underrunTime_;
+	uint64_t errors_;
+	uint64_t cancelled_;
+};
+
+} /* namespace libcamera */
+
+#endif /* __LIBCAMERA_FRAME_STATISTICS_H__ */
@@ -17,6 +17,8 @@
 
 namespace libcamera {
 
+class IPAProxyFactory;
+
 class IPAManager
 {
 public:
@@ -28,11 +30,15 @@ public:
 
 private:
 	std::vector<IPAModule *> modules_;
+	unsigned int poolSize_;
 
 	IPAManager();
 	~IPAManager();
 
 	int addDir(const char *libDir);
+
+	IPAProxyFactory *proxyFactory() const;
+	void preparePools(unsigned int count);
 };
 
 } /* namespace libcamera */
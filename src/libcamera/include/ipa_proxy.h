@@ -8,6 +8,7 @@
 #define __LIBCAMERA_IPA_PROXY_H__
 
 #include <memory>
+#include <stdint.h>
 #include <string>
 #include <vector>
 
@@ -18,6 +19,12 @@
 
 namespace libcamera {
 
+enum IPAProxyOperation : uint32_t {
+	IPAProxyInit = 1,
+	IPAProxyProcessEvent,
+	IPAProxyQueueFrameAction,
+};
+
 class IPAProxy : public IPAInterface
 {
 public:
@@ -26,8 +33,10 @@ public:
 
 	bool isValid() const { return valid_; }
 
+	static void prepare(IPAModule *ipam, unsigned int count) {}
+
 protected:
-	std::string resolvePath(const std::string &file) const;
+	static std::string resolvePath(const std::string &file);
 
 	bool valid_;
 };
@@ -39,6 +48,7 @@ public:
 	virtual ~IPAProxyFactory(){};
 
 	virtual std::unique_ptr<IPAProxy> create(IPAModule *ipam) = 0;
+	virtual void prepare(IPAModule *ipam, unsigned int count) = 0;
 
 	const std::string &name() const { return name_; }
 
@@ -58,6 +68,10 @@ public:							\
 	{						\
 		return utils::make_unique<proxy>(ipam);	\
 	}						\
+	void prepare(IPAModule *ipam, unsigned int count)	\
+	{						\
+		proxy::prepare(ipam, count);		\
+	}						\
 };							\
 static proxy##Factory global_##proxy##Factory;
 
@@ -0,0 +1,64 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * ipc_ring.h - Shared memory ring buffer for IPC
+ */
+#ifndef __LIBCAMERA_IPC_RING_H__
+#define __LIBCAMERA_IPC_RING_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace libcamera {
+
+class IPCRing
+{
+public:
+	IPCRing();
+	~IPCRing();
+
+	int create(const char *name, size_t size);
+	int bind(int fd);
+	void close();
+
+	bool isValid() const { return header_ != nullptr; }
+	int fd() const { return fd_; }
+	size_t size() const { return size_; }
+
+	void *reserve(size_t length);
+	void commit();
+	void cancel();
+	void revert();
+
+	const void *peek(size_t *length);
+	void release();
+
+private:
+	struct Header;
+
+	IPCRing(const IPCRing &) = delete;
+	IPCRing &operator=(const IPCRing &) = delete;
+
+	int map(int fd, size_t mapSize);
+
+	int fd_;
+	Header *header_;
+	uint8_t *data_;
+	uint32_t size_;
+	size_t mapSize_;
+
+	bool reserved_;
+	uint32_t reservedHead_;
+	uint32_t reservedLength_;
+
+	bool committed_;
+	uint32_t committedHead_;
+
+	bool peeked_;
+	uint32_t peekedLength_;
+};
+
+} /* namespace libcamera */
+
+#endif /* __LIBCAMERA_IPC_RING_H__ */
@@ -0,0 +1,105 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * ipc_ring_channel.h - IPC mechanism based on shared memory ring buffers
+ */
+#ifndef __LIBCAMERA_IPC_RING_CHANNEL_H__
+#define __LIBCAMERA_IPC_RING_CHANNEL_H__
+
+#include <cstdint>
+#include <errno.h>
+#include <vector>
+
+#include <libcamera/signal.h>
+
+#include "ipc_ring.h"
+#include "ipc_serializer.h"
+#include "ipc_unixsocket.h"
+
+namespace libcamera {
+
+class IPCRingChannel
+{
+public:
+	using Payload = IPCUnixSocket::Payload;
+
+	static constexpr size_t DefaultRingSize = 256 * 1024;
+
+	IPCRingChannel(size_t ringSize = DefaultRingSize);
+	~IPCRingChannel();
+
+	int create();
+	int bind(int fd);
+	void close();
+	bool isBound() const;
+
+	int send(const Payload &payload);
+	int receive(Payload *payload);
+
+	void *reserve(size_t length);
+	int commit(const std::vector<int32_t> &fds);
+
+	const void *acquire(size_t *length, std::vector<int32_t> *fds);
+	void release();
+
+	template<typename... Args>
+	int write(const Args &... args);
+
+	Signal<IPCRingChannel *> readyRead;
+
+private:
+	enum MessageType : uint8_t {
+		MessageInline,
+		MessageRing,
+		MessageRingSetup,
+	};
+
+	int sendDoorbell(const std::vector<int32_t> &fds);
+	void socketReadyRead(IPCUnixSocket *socket);
+
+	size_t ringSize_;
+	IPCUnixSocket socket_;
+	IPCRing tx_;
+	IPCRing rx_;
+	bool txShared_;
+
+	Payload doorbell_;
+	bool acquiredRing_;
+
+	Payload message_;
+	std::vector<int32_t> fds_;
+};
+
+template<typename... Args>
+int IPCRingChannel::write(const Args &... args)
+{
+	size_t size = IPCSerializer::size(args...);
+
+	fds_.clear();
+
+	void *data = reserve(size);
+	if (data) {
+		IPCSerializer serializer(data, size, &fds_);
+		if (!serializer.write(args...)) {
+			tx_.cancel();
+			return -EINVAL;
+		}
+
+		return commit(fds_);
+	}
+
+	message_.data.resize(size + 1);
+	message_.data[0] = MessageInline;
+	message_.fds.clear();
+
+	IPCSerializer serializer(message_.data.data() + 1, size, &message_.fds);
+	if (!serializer.write(args...))
+		return -EINVAL;
+
+	return socket_.send(message_);
+}
+
+} /* namespace libcamera */
+
+#endif /* __LIBCAMERA_IPC_RING_CHANNEL_H__ */
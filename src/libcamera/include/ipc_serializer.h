@@ -0,0 +1,296 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * ipc_serializer.h - Serialization of IPC message arguments
+ */
+#ifndef __LIBCAMERA_IPC_SERIALIZER_H__
+#define __LIBCAMERA_IPC_SERIALIZER_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+#include <vector>
+
+#include <libcamera/controls.h>
+#include <libcamera/ipa/ipa_interface.h>
+
+namespace libcamera {
+
+class IPCSerializer;
+class IPCDeserializer;
+
+struct IPCFd {
+	int32_t fd;
+};
+
+class IPCControlListView
+{
+public:
+	class const_iterator
+	{
+	public:
+		const_iterator(const uint8_t *data)
+			: data_(data) {}
+
+		ControlId id() const;
+		ControlValue value() const;
+
+		const_iterator &operator++();
+		bool operator!=(const const_iterator &other) const
+		{
+			return data_ != other.data_;
+		}
+		const const_iterator &operator*() const { return *this; }
+
+	private:
+		const uint8_t *data_;
+	};
+
+	IPCControlListView()
+		: data_(nullptr), count_(0) {}
+	IPCControlListView(const uint8_t *data, uint32_t count)
+		: data_(data), count_(count) {}
+
+	const_iterator begin() const { return const_iterator(data_); }
+	const_iterator end() const;
+
+	bool empty() const { return count_ == 0; }
+	std::size_t size() const { return count_; }
+
+private:
+	const uint8_t *data_;
+	uint32_t count_;
+};
+
+#ifndef __DOXYGEN__
+template<typename T, typename Enable = void>
+struct IPCDataSerializer;
+
+template<typename T>
+struct IPCDataSerializer<T, typename std::enable_if<std::is_arithmetic<T>::value ||
+						    std::is_enum<T>::value>::type> {
+	static constexpr size_t FixedSize = sizeof(T);
+
+	static size_t size(const T &value) { return FixedSize; }
+	static void write(IPCSerializer &serializer, const T &value);
+	static void read(IPCDeserializer &deserializer, T *value);
+};
+
+template<>
+struct IPCDataSerializer<IPCFd> {
+	static constexpr size_t FixedSize = sizeof(uint32_t);
+
+	static size_t size(const IPCFd &value) { return FixedSize; }
+	static void write(IPCSerializer &serializer, const IPCFd &value);
+	static void read(IPCDeserializer &deserializer, IPCFd *value);
+};
+
+template<>
+struct IPCDataSerializer<ControlValue> {
+	static constexpr size_t FixedSize = sizeof(uint8_t) + sizeof(int64_t);
+
+	static size_t size(const ControlValue &value) { return FixedSize; }
+	static void write(IPCSerializer &serializer, const ControlValue &value);
+	static void read(IPCDeserializer &deserializer, ControlValue *value);
+};
+
+template<>
+struct IPCDataSerializer<ControlList> {
+	static constexpr size_t FixedSize = 0;
+	static constexpr size_t EntrySize = sizeof(uint32_t) +
+					    IPCDataSerializer<ControlValue>::FixedSize;
+
+	static size_t size(const ControlList &value)
+	{
+		return sizeof(uint32_t) + value.size() * EntrySize;
+	}
+	static void write(IPCSerializer &serializer, const ControlList &value);
+	static void read(IPCDeserializer &deserializer, ControlList *value);
+};
+
+template<>
+struct IPCDataSerializer<IPCControlListView> {
+	static constexpr size_t FixedSize = 0;
+
+	static void read(IPCDeserializer &deserializer, IPCControlListView *value);
+};
+
+template<typename T>
+struct IPCDataSerializer<std::vector<T>> {
+	static constexpr size_t FixedSize = 0;
+
+	static size_t size(const std::vector<T> &value);
+	static void write(IPCSerializer &serializer, const std::vector<T> &value);
+	static void read(IPCDeserializer &deserializer, std::vector<T> *value);
+};
+
+template<>
+void IPCDataSerializer<std::vector<ControlList>>::read(IPCDeserializer &deserializer,
+							std::vector<ControlList> *value);
+
+template<>
+struct IPCDataSerializer<IPAOperationData> {
+	static constexpr size_t FixedSize = 0;
+
+	static size_t size(const IPAOperationData &value);
+	static void write(IPCSerializer &serializer, const IPAOperationData &value);
+	static void read(IPCDeserializer &deserializer, IPAOperationData *value);
+};
+
+template<typename... Args>
+struct IPCFixedSize;
+
+template<>
+struct IPCFixedSize<> {
+	static constexpr size_t value = 0;
+};
+
+template<typename T, typename... Args>
+struct IPCFixedSize<T, Args...> {
+	static constexpr size_t value =
+		IPCDataSerializer<T>::FixedSize &&
+		(!sizeof...(Args) || IPCFixedSize<Args...>::value)
+		? IPCDataSerializer<T>::FixedSize + IPCFixedSize<Args...>::value
+		: 0;
+};
+#endif /* __DOXYGEN__ */
+
+class IPCSerializer
+{
+public:
+	IPCSerializer(void *data, size_t size,
+		      std::vector<int32_t> *fds = nullptr);
+
+	static size_t size() { return 0; }
+
+	template<typename T, typename... Args>
+	static size_t size(const T &value, const Args &... args)
+	{
+		return IPCDataSerializer<T>::size(value) + size(args...);
+	}
+
+	bool write() { return valid_; }
+
+	template<typename T, typename... Args>
+	bool write(const T &value, const Args &... args)
+	{
+		IPCDataSerializer<T>::write(*this, value);
+		return write(args...);
+	}
+
+	void *reserve(size_t length);
+	void writeFd(int32_t fd);
+
+	bool valid() const { return valid_; }
+	size_t length() const { return offset_; }
+
+private:
+	uint8_t *data_;
+	size_t size_;
+	size_t offset_;
+	std::vector<int32_t> *fds_;
+	bool valid_;
+};
+
+class IPCDeserializer
+{
+public:
+	IPCDeserializer(const void *data, size_t size,
+			const std::vector<int32_t> *fds = nullptr,
+			const ControlInfoMap *controls = nullptr);
+
+	bool read() { return valid_; }
+
+	template<typename T, typename... Args>
+	bool read(T *value, Args *... args)
+	{
+		IPCDataSerializer<T>::read(*this, value);
+		return read(args...);
+	}
+
+	const void *consume(size_t length);
+	int32_t readFd();
+
+	const ControlInfoMap *controls() const { return controls_; }
+
+	void fail() { valid_ = false; }
+	bool valid() const { return valid_; }
+	size_t remaining() const { return size_ - offset_; }
+
+private:
+	const uint8_t *data_;
+	size_t size_;
+	size_t offset_;
+	const std::vector<int32_t> *fds_;
+	const ControlInfoMap *controls_;
+	bool valid_;
+};
+
+#ifndef __DOXYGEN__
+template<typename T>
+void IPCDataSerializer<T, typename std::enable_if<std::is_arithmetic<T>::value ||
+						  std::is_enum<T>::value>::type>::
+write(IPCSerializer &serializer, const T &value)
+{
+	void *data = serializer.reserve(sizeof(value));
+	if (data)
+		memcpy(data, &value, sizeof(value));
+}
+
+template<typename T>
+void IPCDataSerializer<T, typename std::enable_if<std::is_arithmetic<T>::value ||
+						  std::is_enum<T>::value>::type>::
+read(IPCDeserializer &deserializer, T *value)
+{
+	const void *data = deserializer.consume(sizeof(*value));
+	if (data)
+		memcpy(value, data, sizeof(*value));
+}
+
+template<typename T>
+size_t IPCDataSerializer<std::vector<T>>::size(const std::vector<T> &value)
+{
+	size_t size = sizeof(uint32_t);
+	for (const T &element : value)
+		size += IPCDataSerializer<T>::size(element);
+	return size;
+}
+
+template<typename T>
+void IPCDataSerializer<std::vector<T>>::write(IPCSerializer &serializer,
+					      const std::vector<T> &value)
+{
+	uint32_t count = value.size();
+	serializer.write(count);
+
+	for (const T &element : value)
+		IPCDataSerializer<T>::write(serializer, element);
+}
+
+template<typename T>
+void IPCDataSerializer<std::vector<T>>::read(IPCDeserializer &deserializer,
+					     std::vector<T> *value)
+{
+	uint32_t count = 0;
+	if (!deserializer.read(&count))
+		return;
+
+	/* Bound the count by the data left before resizing the vector. */
+	size_t minSize = IPCDataSerializer<T>::FixedSize
+		       ? IPCDataSerializer<T>::FixedSize : sizeof(uint32_t);
+	if (count > deserializer.remaining() / minSize) {
+		deserializer.fail();
+		return;
+	}
+
+	value->resize(count);
+	for (T &element : *value)
+		IPCDataSerializer<T>::read(deserializer, &element);
+}
+#endif /* __DOXYGEN__ */
+
+} /* namespace libcamera */
+
+#endif /* __LIBCAMERA_IPC_SERIALIZER_H__ */
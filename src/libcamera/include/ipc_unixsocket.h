@@ -43,14 +43,15 @@ private:
 		uint8_t fds;
 	};
 
-	int sendData(const void *buffer, size_t length, const int32_t *fds, unsigned int num);
-	int recvData(void *buffer, size_t length, int32_t *fds, unsigned int num);
+	int sendData(const Header &header, const void *buffer, size_t length,
+		     const int32_t *fds, unsigned int num);
+	int recvData(Payload *payload);
 
 	void dataNotifier(EventNotifier *notifier);
 
 	int fd_;
-	bool headerReceived_;
-	struct Header header_;
+	bool pending_;
+	Payload payload_;
 	EventNotifier *notifier_;
 };
 
@@ -0,0 +1,44 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * latency_histogram.h - Latency histogram
+ */
+#ifndef __LIBCAMERA_LATENCY_HISTOGRAM_H__
+#define __LIBCAMERA_LATENCY_HISTOGRAM_H__
+
+#include <array>
+#include <stdint.h>
+
+#include <libcamera/camera.h>
+
+namespace libcamera {
+
+class LatencyHistogram
+{
+public:
+	LatencyHistogram();
+
+	void record(uint64_t latency);
+	void reset();
+
+	LatencyStatistics statistics() const;
+
+private:
+	static constexpr unsigned int SubBucketBits = 3;
+	static constexpr unsigned int SubBuckets = 1 << SubBucketBits;
+	static constexpr unsigned int Buckets = (64 - SubBucketBits + 1) * SubBuckets;
+
+	static unsigned int bucket(uint64_t latency);
+	static uint64_t bucketUpperBound(unsigned int bucket);
+
+	uint64_t percentile(unsigned int percent) const;
+
+	std::array<uint32_t, Buckets> counts_;
+	uint64_t count_;
+	uint64_t max_;
+};
+
+} /* namespace libcamera */
+
+#endif /* __LIBCAMERA_LATENCY_HISTOGRAM_H__ */
@@ -8,6 +8,7 @@
 #define __LIBCAMERA_LOG_H__
 
 #include <sstream>
+#include <stdint.h>
 
 namespace libcamera {
 
@@ -29,6 +30,7 @@ public:
 	const char *name() const { return name_; }
 	LogSeverity severity() const { return severity_; }
 	void setSeverity(LogSeverity severity);
+	bool enabled(LogSeverity severity) const { return severity >= severity_; }
 
 	static const LogCategory &defaultCategory();
 
@@ -66,6 +68,10 @@ private:
 	std::ostringstream msgStream_;
 	const LogCategory &category_;
 	LogSeverity severity_;
+
+	const char *fileName_;
+	unsigned int line_;
+	uint64_t timestamp_;
 };
 
 class Loggable
@@ -90,9 +96,27 @@ LogMessage _log(const char *file, unsigned int line,
 #ifndef __DOXYGEN__
 #define _LOG_CATEGORY(name) logCategory##name
 
+/*
+ * Check the severity before constructing the log message, so that disabled
+ * log statements neither construct any object nor evaluate their arguments.
+ * The & operator has a lower precedence than <<, LogVoidify thus turns the
+ * whole stream expression into a void expression matching the other branch
+ * of the conditional operator.
+ */
+class LogVoidify
+{
+public:
+	void operator&(std::ostream &) {}
+};
+
+#define _LOG_IF(category, severity) \
+	!(category).enabled(severity) ? (void)0 : LogVoidify() &
+
 #define _LOG1(severity) \
+	_LOG_IF(LogCategory::defaultCategory(), Log##severity) \
 	_log(__FILE__, __LINE__, Log##severity).stream()
 #define _LOG2(category, severity) \
+	_LOG_IF(_LOG_CATEGORY(category)(), Log##severity) \
 	_log(__FILE__, __LINE__, _LOG_CATEGORY(category)(), Log##severity).stream()
 
 /*
@@ -0,0 +1,107 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * log_format.h - Log file formats
+ */
+#ifndef __LIBCAMERA_LOG_FORMAT_H__
+#define __LIBCAMERA_LOG_FORMAT_H__
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+
+namespace libcamera {
+
+/*
+ * A binary log file starts with a LogFileHeader, followed by a sequence of
+ * records. Each record starts with a one byte LogRecordType. Category and
+ * location records define the strings referenced by message records by id,
+ * and are written once, before the first message record that references
+ * them. All fields are stored in host byte order.
+ */
+
+#define LOG_FILE_MAGIC		"LCAMLOG"
+#define LOG_FILE_VERSION	1
+
+struct LogFileHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t reserved;
+} __attribute__((packed));
+
+enum LogRecordType {
+	LogRecordCategory = 1,
+	LogRecordLocation = 2,
+	LogRecordMessage = 3,
+	LogRecordDropped = 4,
+};
+
+/* Followed by the category name, without a terminating null character. */
+struct LogCategoryRecord {
+	uint8_t type;
+	uint16_t id;
+	uint16_t length;
+} __attribute__((packed));
+
+/* Followed by the file name, without a terminating null character. */
+struct LogLocationRecord {
+	uint8_t type;
+	uint32_t id;
+	uint32_t line;
+	uint16_t length;
+} __attribute__((packed));
+
+/* Followed by the message text, without a terminating newline. */
+struct LogMessageRecord {
+	uint8_t type;
+	uint8_t severity;
+	uint16_t category;
+	uint32_t location;
+	uint64_t timestamp;
+	uint32_t length;
+} __attribute__((packed));
+
+struct LogDroppedRecord {
+	uint8_t type;
+	uint64_t count;
+} __attribute__((packed));
+
+/*
+ * The text format helpers are shared between the logger and the binary log
+ * decoder, which renders binary log files in the text format.
+ */
+inline const char *log_severity_name(unsigned int severity)
+{
+	static const char *const names[] = {
+		"  DBG",
+		" INFO",
+		" WARN",
+		"  ERR",
+		"FATAL",
+	};
+
+	if (severity < sizeof(names) / sizeof(names[0]))
+		return names[severity];
+	else
+		return "UNKWN";
+}
+
+/* Append the text line prefix for a timestamp expressed in nanoseconds. */
+inline void log_format_timestamp(uint64_t timestamp, std::string *output)
+{
+	uint64_t seconds = timestamp / 1000000000;
+	char text[48];
+
+	snprintf(text, sizeof(text),
+		 "[%" PRIu64 ":%02" PRIu64 ":%02" PRIu64 ".%09" PRIu64 "] ",
+		 seconds / (60 * 60), (seconds / 60) % 60, seconds % 60,
+		 timestamp % 1000000000);
+
+	output->append(text);
+}
+
+} /* namespace libcamera */
+
+#endif /* __LIBCAMERA_LOG_FORMAT_H__ */
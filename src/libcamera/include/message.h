@@ -7,6 +7,8 @@
 #ifndef __LIBCAMERA_MESSAGE_H__
 #define __LIBCAMERA_MESSAGE_H__
 
+#include <cstddef>
+
 namespace libcamera {
 
 class Object;
@@ -27,11 +29,16 @@ public:
 	Type type() const { return type_; }
 	Object *receiver() const { return receiver_; }
 
+	static void *operator new(std::size_t size);
+	static void operator delete(void *ptr);
+
 private:
+	friend class MessageQueue;
 	friend class Thread;
 
 	Type type_;
 	Object *receiver_;
+	Message *next_;
 };
 
 class SignalMessage : public Message
@@ -46,6 +53,15 @@ public:
 	void *pack_;
 };
 
+class MessageAllocator
+{
+public:
+	static constexpr std::size_t BlockSize = 128;
+
+	static void *allocate(std::size_t size);
+	static void free(void *mem);
+};
+
 } /* namespace libcamera */
 
 #endif /* __LIBCAMERA_MESSAGE_H__ */
@@ -7,7 +7,6 @@
 #ifndef __LIBCAMERA_PIPELINE_HANDLER_H__
 #define __LIBCAMERA_PIPELINE_HANDLER_H__
 
-#include <list>
 #include <map>
 #include <memory>
 #include <set>
@@ -41,7 +40,7 @@ public:
 
 	Camera *camera_;
 	PipelineHandler *pipe_;
-	std::list<Request *> queuedRequests_;
+	std::vector<Request *> queuedRequests_;
 	ControlInfoMap controlInfo_;
 
 private:
@@ -63,6 +62,7 @@ public:
 	void unlock();
 
 	const ControlInfoMap &controls(Camera *camera);
+	std::map<Stream *, StreamStatistics> statistics(Camera *camera);
 
 	virtual CameraConfiguration *generateConfiguration(Camera *camera,
 		const StreamRoles &roles) = 0;
@@ -72,12 +72,17 @@ public:
 				    const std::set<Stream *> &streams) = 0;
 	virtual int freeBuffers(Camera *camera,
 				const std::set<Stream *> &streams) = 0;
+	virtual int addBuffers(Camera *camera, Stream *stream,
+			       unsigned int count);
 
 	virtual int start(Camera *camera) = 0;
 	virtual void stop(Camera *camera) = 0;
 
 	virtual int queueRequest(Camera *camera, Request *request);
 
+	virtual StreamStatistics streamStatistics(Camera *camera,
+						  Stream *stream);
+
 	bool completeBuffer(Camera *camera, Request *request, Buffer *buffer);
 	void completeRequest(Camera *camera, Request *request);
 
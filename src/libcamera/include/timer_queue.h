@@ -0,0 +1,46 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * timer_queue.h - Deadline-ordered timer queue
+ */
+#ifndef __LIBCAMERA_TIMER_QUEUE_H__
+#define __LIBCAMERA_TIMER_QUEUE_H__
+
+#include <stdint.h>
+#include <vector>
+
+namespace libcamera {
+
+class Timer;
+
+class TimerQueue
+{
+public:
+	TimerQueue();
+	~TimerQueue();
+
+	int fd() const { return fd_; }
+
+	void add(Timer *timer);
+	void remove(Timer *timer);
+
+	void process();
+
+private:
+	bool queued(Timer *timer) const;
+
+	void place(Timer *timer, unsigned int index);
+	void siftUp(unsigned int index);
+	void siftDown(unsigned int index);
+	void arm();
+
+	std::vector<Timer *> timers_;
+	int fd_;
+	uint64_t armed_;
+	bool processing_;
+};
+
+} /* namespace libcamera */
+
+#endif /* __LIBCAMERA_TIMER_QUEUE_H__ */
@@ -0,0 +1,78 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * trace.h - Trace event recording
+ */
+#ifndef __LIBCAMERA_TRACE_H__
+#define __LIBCAMERA_TRACE_H__
+
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "utils.h"
+
+namespace libcamera {
+
+class Tracer
+{
+public:
+	static Tracer *instance();
+
+	static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+	void write(const char *category, const char *name,
+		   uint64_t start, uint64_t end);
+	void stop();
+
+private:
+	static constexpr uint64_t FlushInterval = 1000000000;
+
+	Tracer();
+	~Tracer();
+
+	bool parseTraceFile();
+
+	static std::atomic<bool> enabled_;
+
+	std::mutex mutex_;
+	std::ofstream file_;
+	bool empty_;
+	uint64_t lastFlush_;
+	pid_t pid_;
+};
+
+class TraceScope
+{
+public:
+	TraceScope(const char *category, const char *name)
+		: category_(category), name_(name), start_(0)
+	{
+		if (Tracer::enabled())
+			start_ = utils::clock_monotonic();
+	}
+
+	~TraceScope()
+	{
+		if (start_)
+			Tracer::instance()->write(category_, name_, start_,
+						  utils::clock_monotonic());
+	}
+
+private:
+	TraceScope(const TraceScope &) = delete;
+	TraceScope &operator=(const TraceScope &) = delete;
+
+	const char *category_;
+	const char *name_;
+	uint64_t start_;
+};
+
+#define TRACE_SCOPE(category, name) \
+	TraceScope _traceScope(#category, name)
+
+} /* namespace libcamera */
+
+#endif /* __LIBCAMERA_TRACE_H__ */
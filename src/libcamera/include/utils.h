@@ -9,6 +9,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <stdint.h>
 
 #define ARRAY_SIZE(a)	(sizeof(a) / sizeof(a[0]))
 
@@ -27,6 +28,8 @@ std::unique_ptr<T> make_unique(Args&&... args)
 
 char *secure_getenv(const char *name);
 
+uint64_t clock_monotonic();
+
 template<class InputIt1, class InputIt2>
 unsigned int set_overlap(InputIt1 first1, InputIt1 last1,
 			 InputIt2 first2, InputIt2 last2)
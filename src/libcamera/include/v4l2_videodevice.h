@@ -7,6 +7,7 @@
 #ifndef __LIBCAMERA_V4L2_VIDEODEVICE_H__
 #define __LIBCAMERA_V4L2_VIDEODEVICE_H__
 
+#include <bitset>
 #include <string>
 #include <vector>
 
@@ -16,6 +17,7 @@
 #include <libcamera/signal.h>
 
 #include "formats.h"
+#include "frame_statistics.h"
 #include "log.h"
 #include "v4l2_device.h"
 
@@ -27,6 +29,7 @@ class BufferPool;
 class EventNotifier;
 class MediaDevice;
 class MediaEntity;
+struct StreamStatistics;
 
 struct V4L2Capability final : v4l2_capability {
 	const char *driver() const
@@ -136,6 +139,7 @@ public:
 
 	int exportBuffers(BufferPool *pool);
 	int importBuffers(BufferPool *pool);
+	int addBuffers(unsigned int count);
 	int releaseBuffers();
 
 	int queueBuffer(Buffer *buffer);
@@ -145,6 +149,8 @@ public:
 	int streamOn();
 	int streamOff();
 
+	StreamStatistics statistics() const;
+
 	static V4L2VideoDevice *fromEntityName(const MediaDevice *media,
 					       const std::string &entity);
 
@@ -165,6 +171,12 @@ private:
 	std::vector<SizeRange> enumSizes(unsigned int pixelFormat);
 
 	int requestBuffers(unsigned int count);
+	void setBufferPool(BufferPool *pool);
+	int exportPersistentBuffers(BufferPool *pool);
+	int createPersistentBuffers(BufferPool *pool,
+				    const V4L2DeviceFormat &format);
+	bool isPoolCompatible(BufferPool *pool, const V4L2DeviceFormat &format);
+	int exportPlanes(BufferPool *pool, unsigned int first);
 	int createPlane(BufferMemory *buffer, unsigned int index,
 			unsigned int plane, unsigned int length);
 
@@ -177,9 +189,12 @@ private:
 	enum v4l2_memory memoryType_;
 
 	BufferPool *bufferPool_;
-	std::map<unsigned int, Buffer *> queuedBuffers_;
+	std::vector<Buffer *> queuedBuffers_;
+	std::bitset<VIDEO_MAX_FRAME> queuedMask_;
 
 	EventNotifier *fdEvent_;
+
+	FrameStatistics stats_;
 };
 
 } /* namespace libcamera */
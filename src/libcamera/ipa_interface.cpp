@@ -14,9 +14,39 @@
 
 namespace libcamera {
 
+/**
+ * \struct IPAOperationData
+ * \brief Parameters for IPA events and actions
+ *
+ * IPAOperationData carries the parameters of events sent by pipeline handlers
+ * to IPAs with IPAInterface::processEvent(), and of actions sent back by IPAs
+ * through the IPAInterface::queueFrameAction signal. The meaning of the
+ * operation and of its parameters is defined by each pipeline handler and its
+ * IPA.
+ *
+ * \var IPAOperationData::operation
+ * \brief The operation, specific to the pipeline handler and IPA
+ *
+ * \var IPAOperationData::data
+ * \brief Integer parameters, such as frame numbers or buffer IDs
+ *
+ * \var IPAOperationData::controls
+ * \brief Control lists, such as sensor controls to apply
+ */
+
 /**
  * \class IPAInterface
  * \brief Interface for IPA implementation
+ *
+ * Apart from init(), communication between pipeline handlers and IPAs is
+ * asynchronous. Pipeline handlers notify IPAs of frame events, such as
+ * statistics being ready or buffers being mapped, with processEvent(). IPAs
+ * request actions on a given frame, such as applying controls, by emitting the
+ * queueFrameAction signal.
+ *
+ * This allows IPAs running in an isolated process to be driven without ever
+ * blocking the pipeline handler on a round-trip to the IPA process, and lets
+ * the IPA work on multiple frames concurrently.
  */
 
 /**
@@ -24,4 +54,23 @@ namespace libcamera {
  * \brief Initialise the IPAInterface
  */
 
+/**
+ * \fn IPAInterface::processEvent()
+ * \brief Process an event from the pipeline handler
+ * \param[in] event The event to process
+ *
+ * This function notifies the IPA of an event. It shall not block, any
+ * processing that takes significant time shall be performed asynchronously.
+ * Results are reported back through the queueFrameAction signal.
+ */
+
+/**
+ * \var IPAInterface::queueFrameAction
+ * \brief Signal emitted when the IPA requests an action from the pipeline
+ * handler
+ *
+ * The signal carries the frame number the action applies to, and the action
+ * parameters.
+ */
+
 } /* namespace libcamera */
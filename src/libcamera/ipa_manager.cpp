@@ -8,6 +8,7 @@
 #include "ipa_manager.h"
 
 #include <dirent.h>
+#include <stdlib.h>
 #include <string.h>
 #include <sys/types.h>
 
@@ -32,14 +33,12 @@ LOG_DEFINE_CATEGORY(IPAManager)
  */
 
 IPAManager::IPAManager()
+	: poolSize_(0)
 {
 	addDir(IPA_MODULE_DIR);
 
 	const char *modulePaths = utils::secure_getenv("LIBCAMERA_IPA_MODULE_PATH");
-	if (!modulePaths)
-		return;
-
-	while (1) {
+	while (modulePaths) {
 		const char *delim = strchrnul(modulePaths, ':');
 		size_t count = delim - modulePaths;
 
@@ -53,10 +52,23 @@ IPAManager::IPAManager()
 
 		modulePaths += count + 1;
 	}
+
+	/*
+	 * Start warm proxy workers for the modules that need isolation, to
+	 * speed up IPA creation.
+	 */
+	const char *poolSize = utils::secure_getenv("LIBCAMERA_IPA_WORKER_POOL");
+	if (poolSize) {
+		poolSize_ = strtoul(poolSize, nullptr, 10);
+		preparePools(poolSize_);
+	}
 }
 
 IPAManager::~IPAManager()
 {
+	if (poolSize_)
+		preparePools(0);
+
 	for (IPAModule *module : modules_)
 		delete module;
 }
@@ -123,6 +135,43 @@ int IPAManager::addDir(const char *libDir)
 	return count;
 }
 
+/**
+ * \brief Retrieve the proxy factory used to isolate IPA modules
+ * \return The proxy factory, or nullptr if no suitable factory is registered
+ */
+IPAProxyFactory *IPAManager::proxyFactory() const
+{
+	std::vector<IPAProxyFactory *> &factories = IPAProxyFactory::factories();
+
+	for (IPAProxyFactory *factory : factories) {
+		/* TODO: Better matching */
+		if (!strcmp(factory->name().c_str(), "IPAProxyLinux"))
+			return factory;
+	}
+
+	return nullptr;
+}
+
+/**
+ * \brief Set the size of the proxy worker pools
+ * \param[in] count The number of warm workers to keep per IPA module
+ *
+ * Proxy workers are spawned ahead of time for all IPA modules that need to be
+ * isolated, to lower the latency of IPA creation. The pool size is set by the
+ * LIBCAMERA_IPA_WORKER_POOL environment variable.
+ */
+void IPAManager::preparePools(unsigned int count)
+{
+	IPAProxyFactory *pf = proxyFactory();
+	if (!pf)
+		return;
+
+	for (IPAModule *module : modules_) {
+		if (!module->isOpenSource())
+			pf->prepare(module, count);
+	}
+}
+
 /**
  * \brief Create an IPA interface that matches a given pipeline handler
  * \param[in] pipe The pipeline handler that wants a matching IPA interface
@@ -149,17 +198,7 @@ std::unique_ptr<IPAInterface> IPAManager::createIPA(PipelineHandler *pipe,
 		return nullptr;
 
 	if (!m->isOpenSource()) {
-		IPAProxyFactory *pf = nullptr;
-		std::vector<IPAProxyFactory *> &factories = IPAProxyFactory::factories();
-
-		for (IPAProxyFactory *factory : factories) {
-			/* TODO: Better matching */
-			if (!strcmp(factory->name().c_str(), "IPAProxyLinux")) {
-				pf = factory;
-				break;
-			}
-		}
-
+		IPAProxyFactory *pf = proxyFactory();
 		if (!pf) {
 			LOG(IPAManager, Error) << "Failed to get proxy factory";
 			return nullptr;
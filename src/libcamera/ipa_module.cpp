@@ -187,8 +187,9 @@ elfLoadSymbol(void *map, size_t soSize, const char *symbol)
  * \brief The IPA module API version
  *
  * This version number specifies the version for the layout of
- * struct IPAModuleInfo. The IPA module shall use this macro to
- * set its moduleAPIVersion field.
+ * struct IPAModuleInfo and of the IPAInterface created by the module. The IPA
+ * module shall use this macro to set its moduleAPIVersion field. IPA modules
+ * built for a different version are rejected.
  *
  * \sa IPAModuleInfo::moduleAPIVersion
  */
@@ -319,21 +320,25 @@ int IPAModule::loadIPAModuleInfo()
 			elfLoadSymbol<Elf64_Ehdr, Elf64_Shdr, Elf64_Sym>
 				     (map, soSize, "ipaModuleInfo");
 
-	if (data && dataSize == sizeof(info_))
-		memcpy(&info_, data, dataSize);
-
-	if (!data)
+	if (!data || dataSize != sizeof(info_)) {
+		ret = -EINVAL;
 		goto unmap;
+	}
+
+	memcpy(&info_, data, dataSize);
 
 	if (info_.moduleAPIVersion != IPA_MODULE_API_VERSION) {
-		LOG(IPAModule, Error) << "IPA module API version mismatch";
+		LOG(IPAModule, Error)
+			<< "IPA module API version mismatch: got "
+			<< info_.moduleAPIVersion << ", expected "
+			<< IPA_MODULE_API_VERSION;
 		ret = -EINVAL;
 	}
 
 unmap:
 	munmap(map, soSize);
 close:
-	if (ret || !data)
+	if (ret)
 		LOG(IPAModule, Error)
 			<< "Error loading IPA module info for " << libPath_;
 
@@ -24,6 +24,22 @@ namespace libcamera {
 
 LOG_DEFINE_CATEGORY(IPAProxy)
 
+/**
+ * \enum IPAProxyOperation
+ * \brief Operations exchanged between IPA proxies and their workers
+ *
+ * Each message exchanged between a proxy and its worker starts with the
+ * operation, followed by the operation arguments. Only synchronous operations
+ * are replied to, with the operation and its return value.
+ *
+ * \var IPAProxyInit
+ * \brief Call IPAInterface::init()
+ * \var IPAProxyProcessEvent
+ * \brief Call IPAInterface::processEvent(), without reply
+ * \var IPAProxyQueueFrameAction
+ * \brief Emit the IPAInterface::queueFrameAction signal, sent by the worker
+ */
+
 /**
  * \class IPAProxy
  * \brief IPA Proxy
@@ -59,6 +75,18 @@ IPAProxy::~IPAProxy()
  * \return True if the IPAProxy is valid, false otherwise
  */
 
+/**
+ * \fn IPAProxy::prepare()
+ * \brief Prepare resources to speed up creation of proxies for a module
+ * \param[in] ipam The IPA module
+ * \param[in] count The number of proxies to prepare resources for
+ *
+ * IPAProxy subclasses can implement this static function to perform ahead of
+ * time the expensive parts of proxy creation for the IPA module \a ipam, such
+ * as spawning and loading the module in worker processes. The default
+ * implementation does nothing.
+ */
+
 /**
  * \brief Find a valid full path for a proxy worker for a given executable name
  * \param[in] file File name of proxy worker executable
@@ -73,7 +101,7 @@ IPAProxy::~IPAProxy()
  * \return The full path to the proxy worker executable, or an empty string if
  * no valid executable path
  */
-std::string IPAProxy::resolvePath(const std::string &file) const
+std::string IPAProxy::resolvePath(const std::string &file)
 {
 	/* Try finding the exec target from the install directory first */
 	std::string proxyFile = "/" + file;
@@ -156,6 +184,16 @@ IPAProxyFactory::IPAProxyFactory(const char *name)
  * corresponding to the factory
  */
 
+/**
+ * \fn IPAProxyFactory::prepare()
+ * \brief Prepare resources for future instances of the IPAProxy
+ * \param[in] ipam The IPA module
+ * \param[in] count The number of instances to prepare resources for
+ *
+ * This virtual function is implemented by the REGISTER_IPA_PROXY() macro, and
+ * calls the static prepare() function of the IPAProxy subclass.
+ */
+
 /**
  * \fn IPAProxyFactory::name()
  * \brief Retrieve the factory name
@@ -0,0 +1,399 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * ipc_ring.cpp - Shared memory ring buffer for IPC
+ */
+
+#include "ipc_ring.h"
+
+#include <atomic>
+#include <fcntl.h>
+#include <linux/memfd.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "log.h"
+
+/**
+ * \file ipc_ring.h
+ * \brief Shared memory ring buffer for IPC
+ */
+
+namespace libcamera {
+
+LOG_DEFINE_CATEGORY(IPCRing)
+
+namespace {
+
+/* Length value marking the unused end of the ring before wrapping around. */
+constexpr uint32_t WrapMarker = UINT32_MAX;
+
+uint32_t entrySize(uint32_t length)
+{
+	return (sizeof(uint32_t) + length + 7) & ~7;
+}
+
+} /* namespace */
+
+/**
+ * \brief Producer and consumer positions, shared by both processes
+ *
+ * The positions are free-running counters, wrapped to the ring size when
+ * accessing the data. They are stored in separate cache lines to avoid false
+ * sharing between the producer and the consumer.
+ */
+struct IPCRing::Header {
+	/**
+	 * \brief Position of the next entry to be written, updated by the
+	 * producer
+	 */
+	alignas(64) std::atomic<uint32_t> head;
+	/**
+	 * \brief Position of the next entry to be read, updated by the consumer
+	 */
+	alignas(64) std::atomic<uint32_t> tail;
+};
+
+/**
+ * \class IPCRing
+ * \brief Single-producer single-consumer ring buffer in shared memory
+ *
+ * The IPCRing class implements a lock-free ring buffer of variable size
+ * entries, stored in a memfd that can be shared between two processes. One
+ * process creates the ring with create() and passes the file descriptor
+ * returned by fd() to the other process, which maps the ring with bind().
+ * Exactly one of the processes shall then produce entries, and the other one
+ * consume them.
+ *
+ * Entries are written and read in place, without any copy. The producer
+ * reserves space for an entry with reserve(), writes the entry data to the
+ * returned memory, and makes the entry available to the consumer with
+ * commit(). The consumer accesses the oldest entry with peek(), and frees its
+ * space with release() when done. Entries are stored contiguously, the unused
+ * space at the end of the ring is skipped when an entry doesn't fit.
+ *
+ * The memfd is sealed against resizing, and all positions and lengths read
+ * from shared memory are validated, so a misbehaving peer can't cause
+ * accesses outside of the ring.
+ */
+
+IPCRing::IPCRing()
+	: fd_(-1), header_(nullptr), data_(nullptr), size_(0), mapSize_(0),
+	  reserved_(false), reservedHead_(0), reservedLength_(0),
+	  committed_(false), committedHead_(0),
+	  peeked_(false), peekedLength_(0)
+{
+}
+
+IPCRing::~IPCRing()
+{
+	close();
+}
+
+/**
+ * \brief Create a ring buffer
+ * \param[in] name The memfd name, for debugging purpose
+ * \param[in] size The ring buffer size in bytes, shall be a power of two
+ * \return 0 on success or a negative error code otherwise
+ */
+int IPCRing::create(const char *name, size_t size)
+{
+	int ret;
+
+	if (isValid())
+		return -EBUSY;
+
+	if (size < 64 || size > (1U << 30) || (size & (size - 1)))
+		return -EINVAL;
+
+	int fd = syscall(SYS_memfd_create, name, MFD_CLOEXEC | MFD_ALLOW_SEALING);
+	if (fd < 0) {
+		ret = -errno;
+		LOG(IPCRing, Error)
+			<< "Failed to create memfd: " << strerror(-ret);
+		return ret;
+	}
+
+	size_t mapSize = sizeof(Header) + size;
+	if (ftruncate(fd, mapSize) < 0 ||
+	    fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) < 0) {
+		ret = -errno;
+		LOG(IPCRing, Error)
+			<< "Failed to size memfd: " << strerror(-ret);
+		::close(fd);
+		return ret;
+	}
+
+	ret = map(fd, mapSize);
+	if (ret < 0)
+		return ret;
+
+	header_->head.store(0, std::memory_order_relaxed);
+	header_->tail.store(0, std::memory_order_relaxed);
+
+	return 0;
+}
+
+/**
+ * \brief Bind to a ring buffer created by another process
+ * \param[in] fd The ring buffer file descriptor
+ *
+ * The ring takes ownership of \a fd, and closes it when closed.
+ *
+ * \return 0 on success or a negative error code otherwise
+ */
+int IPCRing::bind(int fd)
+{
+	if (isValid())
+		return -EBUSY;
+
+	/* The peer must not be able to shrink the memory under our feet. */
+	int seals = fcntl(fd, F_GET_SEALS);
+	if (seals < 0 || !(seals & F_SEAL_SHRINK)) {
+		LOG(IPCRing, Error) << "Ring memory isn't sealed";
+		::close(fd);
+		return -EINVAL;
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) < 0) {
+		int ret = -errno;
+		::close(fd);
+		return ret;
+	}
+
+	size_t size = st.st_size - sizeof(Header);
+	if (static_cast<size_t>(st.st_size) <= sizeof(Header) ||
+	    size > (1U << 30) || (size & (size - 1))) {
+		LOG(IPCRing, Error) << "Invalid ring size " << st.st_size;
+		::close(fd);
+		return -EINVAL;
+	}
+
+	return map(fd, st.st_size);
+}
+
+/**
+ * \brief Unmap the ring buffer and close its file descriptor
+ */
+void IPCRing::close()
+{
+	if (!isValid())
+		return;
+
+	munmap(header_, mapSize_);
+	::close(fd_);
+
+	fd_ = -1;
+	header_ = nullptr;
+	data_ = nullptr;
+	size_ = 0;
+	mapSize_ = 0;
+	reserved_ = false;
+	committed_ = false;
+	peeked_ = false;
+}
+
+/**
+ * \fn IPCRing::isValid()
+ * \brief Check if the ring buffer has been created or bound
+ * \return True if the ring buffer is valid, false otherwise
+ */
+
+/**
+ * \fn IPCRing::fd()
+ * \brief Retrieve the ring buffer file descriptor
+ * \return The file descriptor, or -1 if the ring buffer isn't valid
+ */
+
+/**
+ * \fn IPCRing::size()
+ * \brief Retrieve the ring buffer size
+ * \return The ring buffer size in bytes
+ */
+
+/**
+ * \brief Reserve space for an entry
+ * \param[in] length The entry length in bytes
+ *
+ * Reserve space for an entry of \a length bytes. The caller shall write the
+ * entry to the returned memory and then call commit(). Only one entry can be
+ * reserved at a time.
+ *
+ * \return A pointer to the entry memory, or nullptr if the ring is full or
+ * \a length is too large
+ */
+void *IPCRing::reserve(size_t length)
+{
+	if (!isValid() || reserved_ || length >= size_)
+		return nullptr;
+
+	uint32_t needed = entrySize(length);
+	if (needed > size_)
+		return nullptr;
+
+	uint32_t head = header_->head.load(std::memory_order_relaxed);
+	uint32_t tail = header_->tail.load(std::memory_order_acquire);
+	uint32_t used = head - tail;
+	if (used > size_)
+		return nullptr;
+
+	/* Skip the end of the ring if the entry doesn't fit contiguously. */
+	uint32_t offset = head & (size_ - 1);
+	uint32_t padding = size_ - offset < needed ? size_ - offset : 0;
+
+	if (size_ - used < padding + needed)
+		return nullptr;
+
+	if (padding) {
+		memcpy(data_ + offset, &WrapMarker, sizeof(WrapMarker));
+		head += padding;
+		offset = 0;
+	}
+
+	reserved_ = true;
+	committed_ = false;
+	reservedHead_ = head;
+	reservedLength_ = length;
+
+	return data_ + offset + sizeof(uint32_t);
+}
+
+/**
+ * \brief Make the reserved entry available to the consumer
+ */
+void IPCRing::commit()
+{
+	if (!reserved_)
+		return;
+
+	uint32_t offset = reservedHead_ & (size_ - 1);
+	memcpy(data_ + offset, &reservedLength_, sizeof(reservedLength_));
+
+	committedHead_ = header_->head.load(std::memory_order_relaxed);
+	committed_ = true;
+
+	header_->head.store(reservedHead_ + entrySize(reservedLength_),
+			    std::memory_order_release);
+	reserved_ = false;
+}
+
+/**
+ * \brief Drop the reserved entry without making it available to the consumer
+ */
+void IPCRing::cancel()
+{
+	reserved_ = false;
+}
+
+/**
+ * \brief Withdraw the last committed entry
+ *
+ * This function restores the producer position to its value before the last
+ * call to commit(), including the padding skipped by reserve() to wrap around.
+ * It is only safe when the caller can guarantee that the consumer hasn't
+ * accessed the entry yet, typically because the consumer hasn't been notified
+ * of its availability. The entry can only be reverted once, and not after
+ * reserving another entry.
+ */
+void IPCRing::revert()
+{
+	if (!committed_ || reserved_)
+		return;
+
+	header_->head.store(committedHead_, std::memory_order_release);
+	committed_ = false;
+}
+
+/**
+ * \brief Access the oldest entry
+ * \param[out] length The entry length in bytes
+ *
+ * The entry stays in the ring until release() is called. Calling peek()
+ * multiple times without calling release() returns the same entry.
+ *
+ * \return A pointer to the entry, or nullptr if the ring is empty or corrupted
+ */
+const void *IPCRing::peek(size_t *length)
+{
+	if (!isValid())
+		return nullptr;
+
+	uint32_t tail = header_->tail.load(std::memory_order_relaxed);
+	uint32_t head = header_->head.load(std::memory_order_acquire);
+
+	while (tail != head) {
+		uint32_t available = head - tail;
+		uint32_t offset = tail & (size_ - 1);
+		uint32_t entryLength;
+
+		if (available > size_ || offset & 7)
+			break;
+
+		memcpy(&entryLength, data_ + offset, sizeof(entryLength));
+
+		if (entryLength == WrapMarker) {
+			if (size_ - offset > available)
+				break;
+
+			tail += size_ - offset;
+			header_->tail.store(tail, std::memory_order_release);
+			continue;
+		}
+
+		if (entryLength > size_ - offset - sizeof(uint32_t) ||
+		    entrySize(entryLength) > available)
+			break;
+
+		peeked_ = true;
+		peekedLength_ = entryLength;
+		*length = entryLength;
+		return data_ + offset + sizeof(uint32_t);
+	}
+
+	if (tail != head)
+		LOG(IPCRing, Error) << "Ring buffer corrupted";
+
+	return nullptr;
+}
+
+/**
+ * \brief Release the entry returned by peek()
+ */
+void IPCRing::release()
+{
+	if (!peeked_)
+		return;
+
+	uint32_t tail = header_->tail.load(std::memory_order_relaxed);
+	header_->tail.store(tail + entrySize(peekedLength_),
+			    std::memory_order_release);
+	peeked_ = false;
+}
+
+int IPCRing::map(int fd, size_t mapSize)
+{
+	void *mem = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED,
+			 fd, 0);
+	if (mem == MAP_FAILED) {
+		int ret = -errno;
+		LOG(IPCRing, Error)
+			<< "Failed to map ring buffer: " << strerror(-ret);
+		::close(fd);
+		return ret;
+	}
+
+	fd_ = fd;
+	header_ = static_cast<Header *>(mem);
+	data_ = static_cast<uint8_t *>(mem) + sizeof(Header);
+	size_ = mapSize - sizeof(Header);
+	mapSize_ = mapSize;
+
+	return 0;
+}
+
+} /* namespace libcamera */
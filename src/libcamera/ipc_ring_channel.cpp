@@ -0,0 +1,344 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * ipc_ring_channel.cpp - IPC mechanism based on shared memory ring buffers
+ */
+
+#include "ipc_ring_channel.h"
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "log.h"
+
+/**
+ * \file ipc_ring_channel.h
+ * \brief IPC mechanism based on shared memory ring buffers
+ */
+
+namespace libcamera {
+
+LOG_DECLARE_CATEGORY(IPCRing)
+
+/**
+ * \class IPCRingChannel
+ * \brief IPC mechanism based on shared memory ring buffers
+ *
+ * The IPCRingChannel class offers the same bidirectional message passing
+ * interface as IPCUnixSocket, but transfers the message data through a pair of
+ * IPCRing shared memory ring buffers, one per direction. The underlying Unix
+ * socket is only used to notify the peer of new messages and to pass file
+ * descriptors, which keeps the socket traffic constant regardless of the
+ * message size.
+ *
+ * Each side of the channel creates the ring buffer it writes to, and passes
+ * its file descriptor to the peer along with the first message, so no
+ * separate handshake is needed. Messages that don't fit in the free space of
+ * the ring are transparently sent inline through the socket.
+ *
+ * In addition to send() and receive(), which copy the message data between
+ * the payload and the ring, the channel offers a zero-copy interface. The
+ * sender writes messages directly to the ring with reserve() and commit(), and
+ * the receiver accesses them in place with acquire() and release().
+ *
+ * The channel is created with create() and bound on the other side with
+ * bind(), in the same way as IPCUnixSocket.
+ */
+
+/**
+ * \typedef IPCRingChannel::Payload
+ * \brief Container for an IPC message, shared with IPCUnixSocket
+ */
+
+/**
+ * \var IPCRingChannel::DefaultRingSize
+ * \brief The default size of the ring buffers, in bytes
+ */
+
+/**
+ * \brief Construct an IPC ring channel
+ * \param[in] ringSize The size of the transmit ring buffer in bytes, shall be
+ * a power of two
+ */
+IPCRingChannel::IPCRingChannel(size_t ringSize)
+	: ringSize_(ringSize), txShared_(false), acquiredRing_(false)
+{
+	socket_.readyRead.connect(this, &IPCRingChannel::socketReadyRead);
+}
+
+IPCRingChannel::~IPCRingChannel()
+{
+	close();
+}
+
+/**
+ * \brief Create a new IPC channel
+ *
+ * This function creates the underlying Unix socket pair, and returns the file
+ * descriptor of the remote end. It shall be passed to the remote process and
+ * bound there with bind().
+ *
+ * \return A file descriptor on success, negative error code on failure
+ */
+int IPCRingChannel::create()
+{
+	return socket_.create();
+}
+
+/**
+ * \brief Bind to an existing IPC channel
+ * \param[in] fd File descriptor of the remote end of the channel
+ *
+ * \return 0 on success or a negative error code otherwise
+ */
+int IPCRingChannel::bind(int fd)
+{
+	return socket_.bind(fd);
+}
+
+/**
+ * \brief Close the IPC channel
+ *
+ * No communication is possible after close() has been called.
+ */
+void IPCRingChannel::close()
+{
+	socket_.close();
+	tx_.close();
+	rx_.close();
+
+	txShared_ = false;
+	doorbell_.data.clear();
+	doorbell_.fds.clear();
+	acquiredRing_ = false;
+}
+
+/**
+ * \brief Check if the IPC channel is bound
+ * \return True if the IPC channel is bound, false otherwise
+ */
+bool IPCRingChannel::isBound() const
+{
+	return socket_.isBound();
+}
+
+/**
+ * \brief Send a message payload
+ * \param[in] payload Message payload to send
+ *
+ * The payload data is copied to the transmit ring buffer, or sent inline
+ * through the socket if the ring doesn't have enough free space.
+ *
+ * \return 0 on success or a negative error code otherwise
+ */
+int IPCRingChannel::send(const Payload &payload)
+{
+	if (!isBound())
+		return -ENOTCONN;
+
+	void *data = reserve(payload.data.size());
+	if (data) {
+		if (!payload.data.empty())
+			memcpy(data, payload.data.data(), payload.data.size());
+		return commit(payload.fds);
+	}
+
+	Payload message;
+	message.data.reserve(payload.data.size() + 1);
+	message.data.push_back(MessageInline);
+	message.data.insert(message.data.end(), payload.data.begin(),
+			    payload.data.end());
+	message.fds = payload.fds;
+
+	return socket_.send(message);
+}
+
+/**
+ * \brief Receive a message payload
+ * \param[out] payload Payload where to write the received message
+ *
+ * This function receives the message payload from the IPC channel and writes
+ * it to the \a payload. It blocks until one message is received, if an
+ * asynchronous behavior is desired this function should be called when the
+ * readyRead signal is emitted.
+ *
+ * \return 0 on success or a negative error code otherwise
+ */
+int IPCRingChannel::receive(Payload *payload)
+{
+	if (!payload)
+		return -EINVAL;
+
+	size_t length;
+	const void *data = acquire(&length, &payload->fds);
+	if (!data)
+		return -EIO;
+
+	const uint8_t *bytes = static_cast<const uint8_t *>(data);
+	payload->data.assign(bytes, bytes + length);
+	release();
+
+	return 0;
+}
+
+/**
+ * \brief Reserve space for a message in the transmit ring buffer
+ * \param[in] length The message length in bytes
+ *
+ * This function returns a pointer to shared memory where the caller shall
+ * write the message data, and then call commit() to send the message. The
+ * transmit ring buffer is created on first use.
+ *
+ * \return A pointer to the message data, or nullptr if the ring doesn't have
+ * enough free space
+ */
+void *IPCRingChannel::reserve(size_t length)
+{
+	if (!isBound())
+		return nullptr;
+
+	if (!tx_.isValid() && tx_.create("libcamera-ipc-ring", ringSize_) < 0)
+		return nullptr;
+
+	return tx_.reserve(length);
+}
+
+/**
+ * \brief Send the message reserved with reserve()
+ * \param[in] fds File descriptors to send along with the message
+ * \return 0 on success or a negative error code otherwise
+ */
+int IPCRingChannel::commit(const std::vector<int32_t> &fds)
+{
+	tx_.commit();
+
+	/*
+	 * The peer reads one ring entry per doorbell, so an entry whose
+	 * doorbell couldn't be sent is never accessed. Withdraw it to keep
+	 * the ring and the doorbells in sync.
+	 */
+	int ret = sendDoorbell(fds);
+	if (ret)
+		tx_.revert();
+
+	return ret;
+}
+
+/**
+ * \fn IPCRingChannel::write()
+ * \brief Serialize arguments and send them as a message
+ * \param[in] args The arguments to serialize
+ *
+ * This function serializes \a args with the IPCSerializer directly in the
+ * transmit ring buffer, and sends the resulting message. If the ring doesn't
+ * have enough free space, the message is serialized to a payload sent inline
+ * through the socket instead. Neither path blocks, and the payload memory is
+ * reused across calls. Nothing is sent if the arguments can't be serialized.
+ *
+ * \return 0 on success, -EINVAL if serialization fails, or a negative error
+ * code if the message can't be sent
+ */
+
+/**
+ * \brief Access the next message in place
+ * \param[out] length The message length in bytes
+ * \param[out] fds The file descriptors received with the message
+ *
+ * This function receives the next message and returns a pointer to its data
+ * without copying it. The data stays valid until release() is called, which
+ * shall be done before acquiring the next message.
+ *
+ * \return A pointer to the message data, or nullptr if an error occurred
+ */
+const void *IPCRingChannel::acquire(size_t *length, std::vector<int32_t> *fds)
+{
+	*length = 0;
+
+	if (socket_.receive(&doorbell_) || doorbell_.data.empty())
+		return nullptr;
+
+	uint8_t type = doorbell_.data[0];
+
+	if (type == MessageInline) {
+		*fds = std::move(doorbell_.fds);
+		*length = doorbell_.data.size() - 1;
+		return doorbell_.data.data() + 1;
+	}
+
+	if (type == MessageRingSetup) {
+		if (rx_.isValid() || doorbell_.fds.empty()) {
+			LOG(IPCRing, Error) << "Unexpected ring setup message";
+			for (int32_t fd : doorbell_.fds)
+				::close(fd);
+			return nullptr;
+		}
+
+		int ret = rx_.bind(doorbell_.fds.back());
+		doorbell_.fds.pop_back();
+		if (ret < 0) {
+			for (int32_t fd : doorbell_.fds)
+				::close(fd);
+			return nullptr;
+		}
+	} else if (type != MessageRing) {
+		LOG(IPCRing, Error) << "Invalid message type "
+				    << static_cast<unsigned int>(type);
+		for (int32_t fd : doorbell_.fds)
+			::close(fd);
+		return nullptr;
+	}
+
+	const void *data = rx_.peek(length);
+	if (!data) {
+		*length = 0;
+		for (int32_t fd : doorbell_.fds)
+			::close(fd);
+		return nullptr;
+	}
+
+	*fds = std::move(doorbell_.fds);
+	acquiredRing_ = true;
+	return data;
+}
+
+/**
+ * \brief Release the message returned by acquire()
+ */
+void IPCRingChannel::release()
+{
+	if (acquiredRing_) {
+		rx_.release();
+		acquiredRing_ = false;
+	}
+}
+
+int IPCRingChannel::sendDoorbell(const std::vector<int32_t> &fds)
+{
+	Payload message;
+
+	message.fds = fds;
+
+	/* Pass the transmit ring to the peer along with the first message. */
+	if (!txShared_) {
+		message.data.push_back(MessageRingSetup);
+		message.fds.push_back(tx_.fd());
+	} else {
+		message.data.push_back(MessageRing);
+	}
+
+	int ret = socket_.send(message);
+	if (ret)
+		return ret;
+
+	txShared_ = true;
+	return 0;
+}
+
+void IPCRingChannel::socketReadyRead(IPCUnixSocket *socket)
+{
+	readyRead.emit(this);
+}
+
+} /* namespace libcamera */
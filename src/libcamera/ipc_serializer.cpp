@@ -0,0 +1,549 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * ipc_serializer.cpp - Serialization of IPC message arguments
+ */
+
+#include "ipc_serializer.h"
+
+#include "controls_internal.h"
+#include "log.h"
+
+/**
+ * \file ipc_serializer.h
+ * \brief Serialization of IPC message arguments
+ *
+ * The IPCSerializer and IPCDeserializer classes marshal the arguments of IPA
+ * method calls to and from a flat buffer. They operate on memory supplied by
+ * the caller, typically a message reserved in place in an IPCRingChannel, and
+ * never allocate memory themselves. The serialization of each argument type is
+ * selected at compile time, and the size of messages made only of fixed-size
+ * arguments is a compile-time constant available through IPCFixedSize.
+ *
+ * The following argument types are supported:
+ *
+ * - Arithmetic types and enumerations, stored in native byte order
+ * - IPCFd, for file descriptors such as dmabufs. The file descriptor is
+ *   transferred out of band, and the message only stores its index
+ * - ControlValue and ControlList
+ * - std::vector of any of the supported types
+ * - IPAOperationData
+ * - IPCControlListView, on the deserialization side only, to access a
+ *   serialized ControlList in place
+ *
+ * All data read from a message is validated, a malformed message puts the
+ * deserializer in an invalid state instead of causing out-of-bounds accesses.
+ */
+
+namespace libcamera {
+
+LOG_DEFINE_CATEGORY(IPCSerializer)
+
+/**
+ * \struct IPCFd
+ * \brief File descriptor argument for IPC messages
+ *
+ * File descriptors can't be copied to the message data, and must be passed
+ * through the IPC channel alongside the message. Wrapping a file descriptor in
+ * an IPCFd makes the serializer append it to the message file descriptors
+ * list and store its index in the message.
+ *
+ * \var IPCFd::fd
+ * \brief The file descriptor
+ */
+
+/**
+ * \class IPCControlListView
+ * \brief Read-only view of a serialized ControlList
+ *
+ * A ControlList can't be deserialized without a ControlInfoMap to resolve
+ * control IDs, and deserializing it requires memory allocation. The
+ * IPCControlListView gives access to the controls of a serialized list in
+ * place, without any copy. The view is only valid as long as the message it
+ * has been read from.
+ *
+ * The control IDs and types are validated when the view is deserialized.
+ */
+
+/**
+ * \class IPCControlListView::const_iterator
+ * \brief Iterator over the controls of an IPCControlListView
+ *
+ * Dereferencing the iterator returns the iterator itself, the control ID and
+ * value are accessed through the id() and value() functions.
+ */
+
+/**
+ * \fn IPCControlListView::const_iterator::const_iterator()
+ * \brief Construct an iterator pointing to a serialized control
+ * \param[in] data Pointer to the serialized control
+ */
+
+/**
+ * \brief Retrieve the ID of the control pointed to by the iterator
+ * \return The control ID
+ */
+ControlId IPCControlListView::const_iterator::id() const
+{
+	uint32_t id;
+	memcpy(&id, data_, sizeof(id));
+	return static_cast<ControlId>(id);
+}
+
+/**
+ * \brief Retrieve the value of the control pointed to by the iterator
+ * \return The control value
+ */
+ControlValue IPCControlListView::const_iterator::value() const
+{
+	IPCDeserializer deserializer(data_ + sizeof(uint32_t),
+				     IPCDataSerializer<ControlValue>::FixedSize);
+	ControlValue value;
+	deserializer.read(&value);
+	return value;
+}
+
+/**
+ * \brief Advance the iterator to the next control
+ * \return A reference to the iterator
+ */
+IPCControlListView::const_iterator &IPCControlListView::const_iterator::operator++()
+{
+	data_ += IPCDataSerializer<ControlList>::EntrySize;
+	return *this;
+}
+
+/**
+ * \fn IPCControlListView::const_iterator::operator!=()
+ * \brief Compare two iterators
+ * \param[in] other The other iterator
+ * \return True if the iterators point to different controls, false otherwise
+ */
+
+/**
+ * \fn IPCControlListView::const_iterator::operator*()
+ * \brief Dereference the iterator
+ * \return A reference to the iterator
+ */
+
+/**
+ * \fn IPCControlListView::IPCControlListView()
+ * \brief Construct an empty view
+ */
+
+/**
+ * \fn IPCControlListView::IPCControlListView(const uint8_t *data, uint32_t count)
+ * \brief Construct a view over serialized controls
+ * \param[in] data Pointer to the first serialized control
+ * \param[in] count Number of controls
+ */
+
+/**
+ * \fn IPCControlListView::begin()
+ * \brief Retrieve an iterator to the first control
+ * \return An iterator to the first control
+ */
+
+/**
+ * \brief Retrieve an iterator past the last control
+ * \return An iterator past the last control
+ */
+IPCControlListView::const_iterator IPCControlListView::end() const
+{
+	return const_iterator(data_ + count_ * IPCDataSerializer<ControlList>::EntrySize);
+}
+
+/**
+ * \fn IPCControlListView::empty()
+ * \brief Check if the view contains no control
+ * \return True if the view is empty, false otherwise
+ */
+
+/**
+ * \fn IPCControlListView::size()
+ * \brief Retrieve the number of controls in the view
+ * \return The number of controls
+ */
+
+/**
+ * \class IPCSerializer
+ * \brief Serialize IPC message arguments to a buffer
+ *
+ * The IPCSerializer writes arguments to a buffer of fixed size provided at
+ * construction time. The required buffer size is computed with size(), which
+ * takes the same arguments as write():
+ *
+ * \code{.cpp}
+ * size_t size = IPCSerializer::size(operation, bufferId, IPCFd{ fd }, controls);
+ * void *data = channel->reserve(size);
+ *
+ * IPCSerializer serializer(data, size, &fds);
+ * serializer.write(operation, bufferId, IPCFd{ fd }, controls);
+ *
+ * channel->commit(fds);
+ * \endcode
+ *
+ * Writing past the end of the buffer marks the serializer as invalid, and the
+ * remaining arguments are ignored.
+ */
+
+/**
+ * \brief Construct a serializer
+ * \param[in] data The buffer to serialize to
+ * \param[in] size The buffer size in bytes
+ * \param[in] fds The list to append file descriptor arguments to
+ *
+ * The \a fds list isn't cleared, to let the caller reuse its memory it should
+ * be cleared before constructing the serializer.
+ */
+IPCSerializer::IPCSerializer(void *data, size_t size, std::vector<int32_t> *fds)
+	: data_(static_cast<uint8_t *>(data)), size_(size), offset_(0),
+	  fds_(fds), valid_(data != nullptr)
+{
+}
+
+/**
+ * \fn IPCSerializer::size(const T &value, const Args &... args)
+ * \brief Compute the serialized size of arguments
+ * \param[in] value The first argument
+ * \param[in] args The other arguments
+ * \return The size in bytes
+ */
+
+/**
+ * \fn IPCSerializer::write(const T &value, const Args &... args)
+ * \brief Serialize arguments
+ * \param[in] value The first argument
+ * \param[in] args The other arguments
+ * \return True if all arguments have been serialized, false if the buffer is
+ * too small
+ */
+
+/**
+ * \brief Reserve space in the buffer
+ * \param[in] length The number of bytes to reserve
+ *
+ * This function is used by the serialization functions of the argument types.
+ *
+ * \return A pointer to the reserved space, or nullptr if the buffer is too
+ * small
+ */
+void *IPCSerializer::reserve(size_t length)
+{
+	if (!valid_ || length > size_ - offset_) {
+		valid_ = false;
+		return nullptr;
+	}
+
+	void *data = data_ + offset_;
+	offset_ += length;
+	return data;
+}
+
+/**
+ * \brief Serialize a file descriptor
+ * \param[in] fd The file descriptor
+ */
+void IPCSerializer::writeFd(int32_t fd)
+{
+	if (!fds_) {
+		LOG(IPCSerializer, Error)
+			<< "File descriptor argument without file descriptor list";
+		valid_ = false;
+		return;
+	}
+
+	uint32_t index = fds_->size();
+	IPCDataSerializer<uint32_t>::write(*this, index);
+	fds_->push_back(fd);
+}
+
+/**
+ * \fn IPCSerializer::valid()
+ * \brief Check if all arguments have been serialized successfully
+ * \return True if the serializer is valid, false otherwise
+ */
+
+/**
+ * \fn IPCSerializer::length()
+ * \brief Retrieve the number of bytes written to the buffer
+ * \return The number of bytes written
+ */
+
+/**
+ * \class IPCDeserializer
+ * \brief Deserialize IPC message arguments from a buffer
+ *
+ * The IPCDeserializer reads arguments from a message in the same order they
+ * have been written by the IPCSerializer. Arguments are passed as pointers to
+ * read(), which returns false if the message is malformed.
+ *
+ * Deserializing a ControlList requires a ControlInfoMap to map control IDs to
+ * controls. When none is specified, a map of all the controls known to
+ * libcamera is used. Controls unknown to the map make the message invalid.
+ */
+
+/**
+ * \brief Construct a deserializer
+ * \param[in] data The buffer to deserialize from
+ * \param[in] size The buffer size in bytes
+ * \param[in] fds The file descriptors received with the message
+ * \param[in] controls The controls used to deserialize control lists
+ */
+IPCDeserializer::IPCDeserializer(const void *data, size_t size,
+				 const std::vector<int32_t> *fds,
+				 const ControlInfoMap *controls)
+	: data_(static_cast<const uint8_t *>(data)), size_(size), offset_(0),
+	  fds_(fds), controls_(controls), valid_(data != nullptr)
+{
+}
+
+/**
+ * \fn IPCDeserializer::read(T *value, Args *... args)
+ * \brief Deserialize arguments
+ * \param[out] value The first argument
+ * \param[out] args The other arguments
+ * \return True if all arguments have been deserialized, false if the message
+ * is malformed
+ */
+
+/**
+ * \brief Consume bytes from the buffer
+ * \param[in] length The number of bytes to consume
+ *
+ * This function is used by the deserialization functions of the argument
+ * types.
+ *
+ * \return A pointer to the consumed bytes, or nullptr if the buffer is too
+ * small
+ */
+const void *IPCDeserializer::consume(size_t length)
+{
+	if (!valid_ || length > size_ - offset_) {
+		valid_ = false;
+		return nullptr;
+	}
+
+	const void *data = data_ + offset_;
+	offset_ += length;
+	return data;
+}
+
+/**
+ * \brief Deserialize a file descriptor
+ * \return The file descriptor, or -1 if the message is malformed
+ */
+int32_t IPCDeserializer::readFd()
+{
+	uint32_t index = 0;
+	IPCDataSerializer<uint32_t>::read(*this, &index);
+	if (!valid_)
+		return -1;
+
+	if (!fds_ || index >= fds_->size()) {
+		valid_ = false;
+		return -1;
+	}
+
+	return (*fds_)[index];
+}
+
+/**
+ * \fn IPCDeserializer::controls()
+ * \brief Retrieve the controls used to deserialize control lists
+ * \return The ControlInfoMap, or nullptr if none has been specified
+ */
+
+/**
+ * \fn IPCDeserializer::fail()
+ * \brief Mark the message as malformed
+ */
+
+/**
+ * \fn IPCDeserializer::valid()
+ * \brief Check if all arguments have been deserialized successfully
+ * \return True if the deserializer is valid, false otherwise
+ */
+
+/**
+ * \fn IPCDeserializer::remaining()
+ * \brief Retrieve the number of bytes left in the buffer
+ * \return The number of bytes left
+ */
+
+#ifndef __DOXYGEN__
+void IPCDataSerializer<IPCFd>::write(IPCSerializer &serializer, const IPCFd &value)
+{
+	serializer.writeFd(value.fd);
+}
+
+void IPCDataSerializer<IPCFd>::read(IPCDeserializer &deserializer, IPCFd *value)
+{
+	value->fd = deserializer.readFd();
+}
+
+void IPCDataSerializer<ControlValue>::write(IPCSerializer &serializer,
+					     const ControlValue &value)
+{
+	uint8_t type = value.type();
+	int64_t data;
+
+	switch (value.type()) {
+	case ControlValueBool:
+		data = value.getBool();
+		break;
+	case ControlValueInteger:
+		data = value.getInt();
+		break;
+	case ControlValueInteger64:
+		data = value.getInt64();
+		break;
+	default:
+		data = 0;
+		break;
+	}
+
+	serializer.write(type, data);
+}
+
+void IPCDataSerializer<ControlValue>::read(IPCDeserializer &deserializer,
+					    ControlValue *value)
+{
+	uint8_t type = 0;
+	int64_t data = 0;
+
+	if (!deserializer.read(&type, &data))
+		return;
+
+	switch (type) {
+	case ControlValueNone:
+		*value = ControlValue();
+		break;
+	case ControlValueBool:
+		value->set(static_cast<bool>(data));
+		break;
+	case ControlValueInteger:
+		value->set(static_cast<int>(data));
+		break;
+	case ControlValueInteger64:
+		value->set(data);
+		break;
+	default:
+		deserializer.fail();
+		break;
+	}
+}
+
+void IPCDataSerializer<ControlList>::write(IPCSerializer &serializer,
+					    const ControlList &value)
+{
+	uint32_t count = value.size();
+	serializer.write(count);
+
+	for (const auto &ctrl : value) {
+		uint32_t id = ctrl.first->id();
+		serializer.write(id, ctrl.second);
+	}
+}
+
+void IPCDataSerializer<ControlList>::read(IPCDeserializer &deserializer,
+					   ControlList *value)
+{
+	const ControlInfoMap *controls = deserializer.controls();
+	if (!controls)
+		controls = &knownControls();
+
+	IPCControlListView view;
+	if (!deserializer.read(&view))
+		return;
+
+	value->clear();
+
+	for (const auto &ctrl : view) {
+		auto iter = controls->find(ctrl.id());
+		if (iter == controls->end()) {
+			deserializer.fail();
+			return;
+		}
+
+		(*value)[&iter->second] = ctrl.value();
+	}
+}
+
+void IPCDataSerializer<IPCControlListView>::read(IPCDeserializer &deserializer,
+						  IPCControlListView *value)
+{
+	uint32_t count = 0;
+	if (!deserializer.read(&count))
+		return;
+
+	constexpr size_t entrySize = IPCDataSerializer<ControlList>::EntrySize;
+	if (count > deserializer.remaining() / entrySize) {
+		deserializer.fail();
+		return;
+	}
+
+	const uint8_t *data =
+		static_cast<const uint8_t *>(deserializer.consume(count * entrySize));
+
+	/* Validate the control IDs and value types to make iteration infallible. */
+	for (uint32_t i = 0; i < count; ++i) {
+		const uint8_t *entry = data + i * entrySize;
+		uint32_t id;
+		memcpy(&id, entry, sizeof(id));
+		uint8_t type = entry[sizeof(id)];
+
+		if (!controlIdentifier(static_cast<ControlId>(id)) ||
+		    type > ControlValueInteger64) {
+			deserializer.fail();
+			return;
+		}
+	}
+
+	*value = IPCControlListView(data, count);
+}
+
+template<>
+void IPCDataSerializer<std::vector<ControlList>>::read(IPCDeserializer &deserializer,
+							std::vector<ControlList> *value)
+{
+	uint32_t count = 0;
+	if (!deserializer.read(&count))
+		return;
+
+	if (count > deserializer.remaining() / sizeof(uint32_t)) {
+		deserializer.fail();
+		return;
+	}
+
+	value->clear();
+	for (uint32_t i = 0; i < count && deserializer.valid(); ++i) {
+		value->emplace_back(nullptr);
+		deserializer.read(&value->back());
+	}
+}
+
+size_t IPCDataSerializer<IPAOperationData>::size(const IPAOperationData &value)
+{
+	return IPCSerializer::size(static_cast<uint32_t>(value.operation),
+				   value.data, value.controls);
+}
+
+void IPCDataSerializer<IPAOperationData>::write(IPCSerializer &serializer,
+						const IPAOperationData &value)
+{
+	serializer.write(static_cast<uint32_t>(value.operation), value.data,
+			 value.controls);
+}
+
+void IPCDataSerializer<IPAOperationData>::read(IPCDeserializer &deserializer,
+					       IPAOperationData *value)
+{
+	uint32_t operation = 0;
+	deserializer.read(&operation, &value->data, &value->controls);
+	value->operation = operation;
+}
+#endif /* __DOXYGEN__ */
+
+} /* namespace libcamera */
@@ -7,12 +7,13 @@
 
 #include "ipc_unixsocket.h"
 
-#include <poll.h>
 #include <string.h>
 #include <sys/socket.h>
 #include <unistd.h>
+#include <utility>
 
 #include "log.h"
+#include "trace.h"
 
 /**
  * \file ipc_unixsocket.h
@@ -62,10 +63,16 @@ LOG_DEFINE_CATEGORY(IPCUnixSocket)
  * communication method. The remote side then instantiates a socket, and binds
  * it to the other side by passing the file descriptor to bind(). At that point
  * the channel is operation and communication is bidirectional and symmmetrical.
+ *
+ * Each message is transported in a single datagram that contains a header
+ * describing the payload, followed by the payload data, with the payload file
+ * descriptors passed as ancillary data. A message is thus sent with a single
+ * sendmsg() call, and received with a single recvmsg() call after peeking at
+ * the header to size the payload.
  */
 
 IPCUnixSocket::IPCUnixSocket()
-	: fd_(-1), headerReceived_(false), notifier_(nullptr)
+	: fd_(-1), pending_(false), notifier_(nullptr)
 {
 }
 
@@ -143,7 +150,7 @@ void IPCUnixSocket::close()
 	::close(fd_);
 
 	fd_ = -1;
-	headerReceived_ = false;
+	pending_ = false;
 }
 
 /**
@@ -167,27 +174,20 @@ bool IPCUnixSocket::isBound() const
  */
 int IPCUnixSocket::send(const Payload &payload)
 {
-	int ret;
+	TRACE_SCOPE(IPC, "IPCUnixSocket::send");
 
 	if (!isBound())
 		return -ENOTCONN;
 
-	Header hdr;
+	Header hdr = {};
 	hdr.data = payload.data.size();
 	hdr.fds = payload.fds.size();
 
 	if (!hdr.data && !hdr.fds)
 		return -EINVAL;
 
-	ret = ::send(fd_, &hdr, sizeof(hdr), 0);
-	if (ret < 0) {
-		ret = -errno;
-		LOG(IPCUnixSocket, Error)
-			<< "Failed to send: " << strerror(-ret);
-		return ret;
-	}
-
-	return sendData(payload.data.data(), hdr.data, payload.fds.data(), hdr.fds);
+	return sendData(hdr, payload.data.data(), hdr.data, payload.fds.data(),
+			hdr.fds);
 }
 
 /**
@@ -199,9 +199,6 @@ int IPCUnixSocket::send(const Payload &payload)
  * immediately with -EAGAIN. The \ref readyRead signal shall be used to receive
  * notification of message availability.
  *
- * \todo Add state machine to make sure we don't block forever and that
- * a header is always followed by a payload.
- *
  * \return 0 on success or a negative error code otherwise
  * \retval -EAGAIN No message payload is available
  * \retval -ENOTCONN The socket is not connected (neither create() nor bind()
@@ -209,22 +206,20 @@ int IPCUnixSocket::send(const Payload &payload)
  */
 int IPCUnixSocket::receive(Payload *payload)
 {
+	TRACE_SCOPE(IPC, "IPCUnixSocket::receive");
+
 	if (!isBound())
 		return -ENOTCONN;
 
-	if (!headerReceived_)
+	if (!pending_)
 		return -EAGAIN;
 
-	payload->data.resize(header_.data);
-	payload->fds.resize(header_.fds);
-
-	int ret = recvData(payload->data.data(), header_.data,
-			   payload->fds.data(), header_.fds);
-	if (ret < 0)
-		return ret;
+	/* Swap the payloads to reuse the memory of the caller's payload. */
+	std::swap(*payload, payload_);
+	pending_ = false;
 
-	headerReceived_ = false;
-	notifier_->setEnabled(true);
+	if (!notifier_->enabled())
+		notifier_->setEnabled(true);
 
 	return 0;
 }
@@ -234,12 +229,14 @@ int IPCUnixSocket::receive(Payload *payload)
  * \brief A Signal emitted when a message is ready to be read
  */
 
-int IPCUnixSocket::sendData(const void *buffer, size_t length,
-			    const int32_t *fds, unsigned int num)
+int IPCUnixSocket::sendData(const Header &header, const void *buffer,
+			    size_t length, const int32_t *fds, unsigned int num)
 {
-	struct iovec iov[1];
-	iov[0].iov_base = const_cast<void *>(buffer);
-	iov[0].iov_len = length;
+	struct iovec iov[2];
+	iov[0].iov_base = const_cast<Header *>(&header);
+	iov[0].iov_len = sizeof(header);
+	iov[1].iov_base = const_cast<void *>(buffer);
+	iov[1].iov_len = length;
 
 	char buf[CMSG_SPACE(num * sizeof(uint32_t))];
 	memset(buf, 0, sizeof(buf));
@@ -253,9 +250,9 @@ int IPCUnixSocket::sendData(const void *buffer, size_t length,
 	msg.msg_name = nullptr;
 	msg.msg_namelen = 0;
 	msg.msg_iov = iov;
-	msg.msg_iovlen = 1;
-	msg.msg_control = cmsg;
-	msg.msg_controllen = cmsg->cmsg_len;
+	msg.msg_iovlen = 2;
+	msg.msg_control = num ? cmsg : nullptr;
+	msg.msg_controllen = num ? cmsg->cmsg_len : 0;
 	msg.msg_flags = 0;
 	memcpy(CMSG_DATA(cmsg), fds, num * sizeof(uint32_t));
 
@@ -269,12 +266,51 @@ int IPCUnixSocket::sendData(const void *buffer, size_t length,
 	return 0;
 }
 
-int IPCUnixSocket::recvData(void *buffer, size_t length,
-			    int32_t *fds, unsigned int num)
+static void close_fds(const struct cmsghdr *cmsg, unsigned int num)
+{
+	for (unsigned int i = 0; i < num; ++i) {
+		int32_t fd;
+		memcpy(&fd, CMSG_DATA(cmsg) + i * sizeof(fd), sizeof(fd));
+		::close(fd);
+	}
+}
+
+int IPCUnixSocket::recvData(Payload *payload)
 {
-	struct iovec iov[1];
-	iov[0].iov_base = buffer;
-	iov[0].iov_len = length;
+	Header header;
+	ssize_t size;
+
+	/*
+	 * Peek at the header to size the payload. MSG_TRUNC returns the full
+	 * datagram size, used to validate the header.
+	 */
+	size = ::recv(fd_, &header, sizeof(header), MSG_PEEK | MSG_TRUNC);
+	if (size < 0) {
+		int ret = -errno;
+		if (ret != -EAGAIN)
+			LOG(IPCUnixSocket, Error)
+				<< "Failed to receive header: " << strerror(-ret);
+		return ret;
+	}
+
+	if (static_cast<size_t>(size) < sizeof(header) ||
+	    static_cast<size_t>(size) != sizeof(header) + header.data) {
+		LOG(IPCUnixSocket, Error) << "Invalid message size " << size;
+		/* Consume the invalid message. */
+		::recv(fd_, &header, 0, 0);
+		return -EINVAL;
+	}
+
+	unsigned int num = header.fds;
+
+	payload->data.resize(header.data);
+	payload->fds.resize(num);
+
+	struct iovec iov[2];
+	iov[0].iov_base = &header;
+	iov[0].iov_len = sizeof(header);
+	iov[1].iov_base = payload->data.data();
+	iov[1].iov_len = header.data;
 
 	char buf[CMSG_SPACE(num * sizeof(uint32_t))];
 	memset(buf, 0, sizeof(buf));
@@ -288,9 +324,9 @@ int IPCUnixSocket::recvData(void *buffer, size_t length,
 	msg.msg_name = nullptr;
 	msg.msg_namelen = 0;
 	msg.msg_iov = iov;
-	msg.msg_iovlen = 1;
-	msg.msg_control = cmsg;
-	msg.msg_controllen = cmsg->cmsg_len;
+	msg.msg_iovlen = 2;
+	msg.msg_control = num ? cmsg : nullptr;
+	msg.msg_controllen = num ? cmsg->cmsg_len : 0;
 	msg.msg_flags = 0;
 
 	if (recvmsg(fd_, &msg, 0) < 0) {
@@ -301,42 +337,63 @@ int IPCUnixSocket::recvData(void *buffer, size_t length,
 		return ret;
 	}
 
-	memcpy(fds, CMSG_DATA(cmsg), num * sizeof(uint32_t));
+	/*
+	 * The header is supplied by the peer and can't be trusted. Check that
+	 * exactly the announced number of file descriptors has been received,
+	 * and close the received ones otherwise.
+	 */
+	cmsg = num ? CMSG_FIRSTHDR(&msg) : nullptr;
+	unsigned int received = 0;
+	if (cmsg && cmsg->cmsg_level == SOL_SOCKET &&
+	    cmsg->cmsg_type == SCM_RIGHTS && cmsg->cmsg_len >= CMSG_LEN(0))
+		received = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int32_t);
+
+	if (msg.msg_flags & MSG_CTRUNC) {
+		LOG(IPCUnixSocket, Error)
+			<< "More than " << num << " file descriptors received";
+		close_fds(cmsg, received);
+		return -EINVAL;
+	}
+
+	if (received != num ||
+	    (num && cmsg->cmsg_len != CMSG_LEN(num * sizeof(int32_t)))) {
+		LOG(IPCUnixSocket, Error)
+			<< "Invalid file descriptors, " << received
+			<< " received, " << num << " expected";
+		close_fds(cmsg, received);
+		return -EINVAL;
+	}
+
+	if (msg.msg_flags & MSG_TRUNC) {
+		LOG(IPCUnixSocket, Error) << "Truncated message";
+		close_fds(cmsg, received);
+		return -EMSGSIZE;
+	}
+
+	if (num)
+		memcpy(payload->fds.data(), CMSG_DATA(cmsg), num * sizeof(int32_t));
 
 	return 0;
 }
 
 void IPCUnixSocket::dataNotifier(EventNotifier *notifier)
 {
-	int ret;
-
-	if (!headerReceived_) {
-		/* Receive the header. */
-		ret = ::recv(fd_, &header_, sizeof(header_), 0);
-		if (ret < 0) {
-			ret = -errno;
-			LOG(IPCUnixSocket, Error)
-				<< "Failed to receive header: " << strerror(-ret);
-			return;
-		}
-
-		headerReceived_ = true;
-	}
-
 	/*
-	 * If the payload has arrived, disable the notifier and emit the
-	 * readyRead signal. The notifier will be reenabled by the receive()
-	 * method.
+	 * If the previous message hasn't been received yet, disable the
+	 * notifier until it gets received to avoid overwriting it. The
+	 * notifier will be reenabled by the receive() method. This only
+	 * happens when the readyRead handler defers reception, the notifier
+	 * is otherwise left enabled.
 	 */
-	struct pollfd fds = { fd_, POLLIN, 0 };
-	ret = poll(&fds, 1, 0);
-	if (ret < 0)
+	if (pending_) {
+		notifier_->setEnabled(false);
 		return;
+	}
 
-	if (!(fds.revents & POLLIN))
+	if (recvData(&payload_) < 0)
 		return;
 
-	notifier_->setEnabled(false);
+	pending_ = true;
 	readyRead.emit(this);
 }
 
@@ -0,0 +1,126 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * latency_histogram.cpp - Latency histogram
+ */
+
+#include "latency_histogram.h"
+
+#include <algorithm>
+
+/**
+ * \file latency_histogram.h
+ * \brief Latency histogram
+ */
+
+namespace libcamera {
+
+/**
+ * \class LatencyHistogram
+ * \brief A fixed-size log-linear histogram of latencies
+ *
+ * The LatencyHistogram class records latency samples in nanoseconds and
+ * computes their percentiles. Samples are stored in buckets whose width doubles
+ * with every power of two, each power of two being split in 8 linear
+ * sub-buckets. This bounds the relative error on percentiles to 12.5% over the
+ * full 64-bit range, with a fixed memory footprint. Recording a sample is
+ * constant-time and never allocates memory.
+ */
+
+LatencyHistogram::LatencyHistogram()
+{
+	reset();
+}
+
+/**
+ * \brief Record a latency sample
+ * \param[in] latency The latency in nanoseconds
+ */
+void LatencyHistogram::record(uint64_t latency)
+{
+	counts_[bucket(latency)]++;
+	count_++;
+
+	if (latency > max_)
+		max_ = latency;
+}
+
+/**
+ * \brief Discard all recorded samples
+ */
+void LatencyHistogram::reset()
+{
+	counts_.fill(0);
+	count_ = 0;
+	max_ = 0;
+}
+
+/**
+ * \brief Compute the statistics of the recorded samples
+ *
+ * Percentiles are reported as the upper bound of the bucket they fall in,
+ * capped to the maximum recorded sample.
+ *
+ * \return The latency statistics
+ */
+LatencyStatistics LatencyHistogram::statistics() const
+{
+	LatencyStatistics stats;
+
+	stats.count = count_;
+	stats.p50 = percentile(50);
+	stats.p99 = percentile(99);
+	stats.max = max_;
+
+	return stats;
+}
+
+/*
+ * Latencies lower than SubBuckets are stored in one bucket each. Higher
+ * latencies are stored in SubBuckets buckets per power of two, indexed by the
+ * position of their most significant bit and by the SubBucketBits following
+ * bits.
+ */
+unsigned int LatencyHistogram::bucket(uint64_t latency)
+{
+	if (latency < SubBuckets)
+		return latency;
+
+	unsigned int msb = 63 - __builtin_clzll(latency);
+	unsigned int shift = msb - SubBucketBits;
+	unsigned int sub = (latency >> shift) & (SubBuckets - 1);
+
+	return (shift + 1) * SubBuckets + sub;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(unsigned int bucket)
+{
+	if (bucket < SubBuckets)
+		return bucket;
+
+	unsigned int shift = bucket / SubBuckets - 1;
+	uint64_t sub = bucket % SubBuckets;
+	uint64_t lower = (SubBuckets + sub) << shift;
+
+	return lower + ((1ULL << shift) - 1);
+}
+
+uint64_t LatencyHistogram::percentile(unsigned int percent) const
+{
+	if (!count_)
+		return 0;
+
+	uint64_t target = (count_ * percent + 99) / 100;
+	uint64_t count = 0;
+
+	for (unsigned int i = 0; i < Buckets; ++i) {
+		count += counts_[i];
+		if (count >= target)
+			return std::min(bucketUpperBound(i), max_);
+	}
+
+	return max_;
+}
+
+} /* namespace libcamera */
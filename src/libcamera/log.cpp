@@ -7,16 +7,26 @@
 
 #include "log.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdio>
 #include <cstdlib>
-#include <ctime>
+#include <fcntl.h>
 #include <fstream>
-#include <iomanip>
 #include <iostream>
+#include <limits.h>
 #include <list>
+#include <map>
+#include <mutex>
 #include <string.h>
+#include <sys/uio.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
 #include <unordered_set>
 
+#include "log_format.h"
 #include "utils.h"
 
 /**
@@ -46,10 +56,452 @@
  * the file. The file must be writable and is truncated if it exists. If any
  * error occurs when opening the file, the file is ignored and the log is output
  * to stderr.
+ *
+ * Messages written to the file set by LIBCAMERA_LOG_FILE are output
+ * asynchronously by a dedicated writer thread, to minimize the impact of
+ * logging on the timing of the threads that log messages. Messages are queued
+ * in a bounded ring buffer, and are dropped when the ring buffer is full. The
+ * number of dropped messages is then reported in the log. Fatal messages are
+ * always written to the log before execution is aborted.
+ *
+ * The file set by LIBCAMERA_LOG_FILE can be written in a compact binary format
+ * instead of text, by setting the LIBCAMERA_LOG_FORMAT environment variable to
+ * "binary". Timestamps, severities, categories and source locations are then
+ * stored as binary fields, with the category names and source locations
+ * written once to the file. The libcamera-log-decode tool renders binary log
+ * files in the text format. The log levels apply to both formats.
  */
 
 namespace libcamera {
 
+/**
+ * \brief A log message and its metadata
+ *
+ * The LogRecord structure stores a log message along with its metadata, to
+ * defer formatting to the log output. The \a category and \a fileName strings
+ * are not copied and shall have a static lifetime.
+ */
+struct LogRecord {
+	uint64_t timestamp;
+	const char *category;
+	LogSeverity severity;
+	const char *fileName;
+	unsigned int line;
+	std::string msg;
+};
+
+/**
+ * \brief Format a log record as a text line
+ * \param[in] record The log record
+ * \param[out] output String to append the text line to
+ */
+static void log_format_text(const LogRecord &record, std::string *output)
+{
+	log_format_timestamp(record.timestamp, output);
+	output->append(log_severity_name(record.severity));
+	output->append(" ");
+	output->append(record.category);
+	output->append(" ");
+	output->append(utils::basename(record.fileName));
+	output->append(":");
+	output->append(std::to_string(record.line));
+	output->append(" ");
+	output->append(record.msg);
+	output->append("\n");
+}
+
+/**
+ * \brief Log record formatter
+ *
+ * The LogFormatter class converts log records to the format of the log file.
+ * Formatters are used from the log writer thread only and may thus keep state
+ * without locking.
+ */
+class LogFormatter
+{
+public:
+	virtual ~LogFormatter() {}
+
+	virtual std::string header() { return std::string(); }
+	virtual void format(const LogRecord &record, std::string *output) = 0;
+	virtual void dropped(uint64_t count, std::string *output) = 0;
+};
+
+/**
+ * \brief Text log record formatter
+ */
+class TextLogFormatter : public LogFormatter
+{
+public:
+	void format(const LogRecord &record, std::string *output) override
+	{
+		log_format_text(record, output);
+	}
+
+	void dropped(uint64_t count, std::string *output) override
+	{
+		output->append("[" + std::to_string(count)
+			       + " log messages dropped]\n");
+	}
+};
+
+/**
+ * \brief Binary log record formatter
+ *
+ * The BinaryLogFormatter class formats log records in the binary log format
+ * defined in log_format.h. Category names and source locations are assigned
+ * ids the first time they are encountered, and their definition records are
+ * output before the message record that references them.
+ */
+class BinaryLogFormatter : public LogFormatter
+{
+public:
+	std::string header() override;
+	void format(const LogRecord &record, std::string *output) override;
+	void dropped(uint64_t count, std::string *output) override;
+
+private:
+	std::unordered_map<const char *, uint16_t> categories_;
+	std::map<std::pair<const char *, unsigned int>, uint32_t> locations_;
+};
+
+std::string BinaryLogFormatter::header()
+{
+	LogFileHeader header = {};
+
+	memcpy(header.magic, LOG_FILE_MAGIC, sizeof(header.magic));
+	header.version = LOG_FILE_VERSION;
+
+	return std::string(reinterpret_cast<const char *>(&header),
+			   sizeof(header));
+}
+
+void BinaryLogFormatter::format(const LogRecord &record, std::string *output)
+{
+	auto category = categories_.find(record.category);
+	if (category == categories_.end()) {
+		uint16_t id = categories_.size();
+		category = categories_.emplace(record.category, id).first;
+
+		size_t length = std::min<size_t>(strlen(record.category), UINT16_MAX);
+		LogCategoryRecord def = { LogRecordCategory, id,
+					  static_cast<uint16_t>(length) };
+		output->append(reinterpret_cast<const char *>(&def), sizeof(def));
+		output->append(record.category, length);
+	}
+
+	auto key = std::make_pair(record.fileName, record.line);
+	auto location = locations_.find(key);
+	if (location == locations_.end()) {
+		uint32_t id = locations_.size();
+		location = locations_.emplace(key, id).first;
+
+		const char *fileName = utils::basename(record.fileName);
+		size_t length = std::min<size_t>(strlen(fileName), UINT16_MAX);
+		LogLocationRecord def = { LogRecordLocation, id, record.line,
+					  static_cast<uint16_t>(length) };
+		output->append(reinterpret_cast<const char *>(&def), sizeof(def));
+		output->append(fileName, length);
+	}
+
+	LogMessageRecord msg = {
+		LogRecordMessage,
+		static_cast<uint8_t>(record.severity),
+		category->second,
+		location->second,
+		record.timestamp,
+		static_cast<uint32_t>(record.msg.size()),
+	};
+	output->append(reinterpret_cast<const char *>(&msg), sizeof(msg));
+	output->append(record.msg);
+}
+
+void BinaryLogFormatter::dropped(uint64_t count, std::string *output)
+{
+	LogDroppedRecord dropped = { LogRecordDropped, count };
+	output->append(reinterpret_cast<const char *>(&dropped), sizeof(dropped));
+}
+
+/**
+ * \brief Asynchronous log writer
+ *
+ * The AsyncLogWriter class decouples the threads that log messages from the
+ * output of the messages to the log file. Messages are pushed to a bounded
+ * lock-free multi-producer ring buffer, and written to the log file in batches
+ * with writev() by a dedicated writer thread.
+ *
+ * Each slot of the ring buffer carries a sequence number that tells whether
+ * the slot is free for the producer that claims it or holds a message ready
+ * to be consumed. Producers claim slots with an atomic compare and swap on the
+ * \ref head_ position and never block. When the ring buffer is full messages
+ * are dropped and counted.
+ */
+class AsyncLogWriter
+{
+public:
+	AsyncLogWriter(int fd, std::unique_ptr<LogFormatter> formatter);
+	~AsyncLogWriter();
+
+	void write(LogRecord &&record);
+	void writeSync(LogRecord &&record);
+
+private:
+	static constexpr unsigned int RingSize = 4096;
+	static constexpr unsigned int BatchSize = 64;
+
+	struct Slot {
+		std::atomic<uint64_t> sequence;
+		LogRecord record;
+	};
+
+	bool push(LogRecord &record);
+	unsigned int pop(LogRecord *records, unsigned int count);
+	void output(const std::string *msgs, unsigned int count);
+	void run();
+
+	int fd_;
+	std::unique_ptr<LogFormatter> formatter_;
+	std::unique_ptr<Slot[]> slots_;
+
+	/* Position of the next slot to be claimed by producers. */
+	std::atomic<uint64_t> head_;
+	/* Position of the next slot to be consumed, writer thread only. */
+	uint64_t tail_;
+	/* Number of messages written to the log file. */
+	std::atomic<uint64_t> written_;
+	std::atomic<uint64_t> dropped_;
+	std::atomic<bool> idle_;
+
+	std::mutex mutex_;
+	std::condition_variable wakeup_;
+	std::condition_variable flushed_;
+	bool exit_;
+
+	std::thread thread_;
+};
+
+/**
+ * \brief Construct an asynchronous log writer
+ * \param[in] fd The log file descriptor
+ * \param[in] formatter The formatter for the log file
+ *
+ * The writer takes ownership of \a fd, and closes it when destroyed.
+ */
+AsyncLogWriter::AsyncLogWriter(int fd, std::unique_ptr<LogFormatter> formatter)
+	: fd_(fd), formatter_(std::move(formatter)), slots_(new Slot[RingSize]),
+	  head_(0), tail_(0),
+	  written_(0), dropped_(0), idle_(false), exit_(false)
+{
+	for (unsigned int i = 0; i < RingSize; ++i)
+		slots_[i].sequence.store(i, std::memory_order_relaxed);
+
+	thread_ = std::thread(&AsyncLogWriter::run, this);
+}
+
+/**
+ * \brief Destroy the asynchronous log writer
+ *
+ * All messages queued before destruction are written to the log file.
+ */
+AsyncLogWriter::~AsyncLogWriter()
+{
+	{
+		std::lock_guard<std::mutex> locker(mutex_);
+		exit_ = true;
+	}
+	wakeup_.notify_one();
+	thread_.join();
+
+	close(fd_);
+}
+
+/**
+ * \brief Queue a record for output
+ * \param[in] record The log record
+ *
+ * This function is lock-free and never blocks, except to wake up the writer
+ * thread when it is idle. If the ring buffer is full the record is dropped.
+ */
+void AsyncLogWriter::write(LogRecord &&record)
+{
+	if (!push(record))
+		dropped_.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * \brief Queue a record and wait until it has been written
+ * \param[in] record The log record
+ *
+ * This is used for records that must reach the log file before the caller
+ * proceeds. The record is never dropped.
+ */
+void AsyncLogWriter::writeSync(LogRecord &&record)
+{
+	/* The writer thread frees slots if the ring buffer is full. */
+	while (!push(record))
+		std::this_thread::yield();
+
+	uint64_t target = head_.load();
+
+	std::unique_lock<std::mutex> locker(mutex_);
+	flushed_.wait(locker, [&]() {
+		return written_.load() >= target || exit_;
+	});
+}
+
+/**
+ * \brief Push a record to the ring buffer
+ * \param[in] record The log record
+ *
+ * The \a record is moved to the ring buffer on success, and left untouched
+ * otherwise.
+ *
+ * \return True if the record has been queued, false if the ring buffer is full
+ */
+bool AsyncLogWriter::push(LogRecord &record)
+{
+	uint64_t pos = head_.load(std::memory_order_relaxed);
+	Slot *slot;
+
+	while (true) {
+		slot = &slots_[pos % RingSize];
+		uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+		int64_t diff = static_cast<int64_t>(sequence - pos);
+
+		if (!diff) {
+			if (head_.compare_exchange_weak(pos, pos + 1,
+							std::memory_order_relaxed))
+				break;
+		} else if (diff < 0) {
+			/* The ring buffer is full. */
+			return false;
+		} else {
+			pos = head_.load(std::memory_order_relaxed);
+		}
+	}
+
+	slot->record = std::move(record);
+	slot->sequence.store(pos + 1, std::memory_order_release);
+
+	if (idle_.load()) {
+		std::lock_guard<std::mutex> locker(mutex_);
+		wakeup_.notify_one();
+	}
+
+	return true;
+}
+
+/**
+ * \brief Consume records from the ring buffer
+ * \param[out] records Array to store the records
+ * \param[in] count Maximum number of records to consume
+ * \return The number of records consumed
+ */
+unsigned int AsyncLogWriter::pop(LogRecord *records, unsigned int count)
+{
+	unsigned int i;
+
+	for (i = 0; i < count; ++i) {
+		Slot &slot = slots_[tail_ % RingSize];
+		uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+		if (sequence != tail_ + 1)
+			break;
+
+		records[i] = std::move(slot.record);
+		slot.record.msg.clear();
+		slot.sequence.store(tail_ + RingSize, std::memory_order_release);
+		tail_++;
+	}
+
+	return i;
+}
+
+/**
+ * \brief Write messages to the log file
+ * \param[in] msgs The messages
+ * \param[in] count The number of messages
+ */
+void AsyncLogWriter::output(const std::string *msgs, unsigned int count)
+{
+	struct iovec iov[BatchSize];
+	unsigned int first = 0;
+
+	for (unsigned int i = 0; i < count; ++i) {
+		iov[i].iov_base = const_cast<char *>(msgs[i].data());
+		iov[i].iov_len = msgs[i].size();
+	}
+
+	/* Resume partial writes, and give up on errors. */
+	while (first < count) {
+		ssize_t ret = writev(fd_, &iov[first], count - first);
+		if (ret < 0) {
+			if (errno == EINTR)
+				continue;
+			return;
+		}
+
+		while (first < count && static_cast<size_t>(ret) >= iov[first].iov_len)
+			ret -= iov[first++].iov_len;
+
+		if (first < count) {
+			iov[first].iov_base = static_cast<char *>(iov[first].iov_base) + ret;
+			iov[first].iov_len -= ret;
+		}
+	}
+}
+
+/**
+ * \brief Main function of the writer thread
+ */
+void AsyncLogWriter::run()
+{
+	LogRecord records[BatchSize];
+	std::string msgs[BatchSize];
+
+	std::string header = formatter_->header();
+	if (!header.empty())
+		output(&header, 1);
+
+	while (true) {
+		unsigned int count = pop(records, BatchSize);
+		if (count) {
+			for (unsigned int i = 0; i < count; ++i) {
+				msgs[i].clear();
+				formatter_->format(records[i], &msgs[i]);
+			}
+
+			output(msgs, count);
+			written_.fetch_add(count);
+
+			std::lock_guard<std::mutex> locker(mutex_);
+			flushed_.notify_all();
+			continue;
+		}
+
+		uint64_t dropped = dropped_.exchange(0, std::memory_order_relaxed);
+		if (dropped) {
+			std::string msg;
+			formatter_->dropped(dropped, &msg);
+			output(&msg, 1);
+		}
+
+		std::unique_lock<std::mutex> locker(mutex_);
+		if (exit_)
+			break;
+
+		/*
+		 * Producers only take the lock to wake us up when we're idle.
+		 * Bound the wait to recover from a wakeup racing with the
+		 * transition to idle.
+		 */
+		idle_.store(true);
+		wakeup_.wait_for(locker, std::chrono::milliseconds(100));
+		idle_.store(false);
+	}
+
+	flushed_.notify_all();
+}
+
 /**
  * \brief Message logger
  *
@@ -60,10 +512,11 @@ class Logger
 public:
 	static Logger *instance();
 
-	void write(const std::string &msg);
+	void write(LogRecord &&record);
 
 private:
 	Logger();
+	~Logger();
 
 	void parseLogFile();
 	void parseLogLevels();
@@ -81,6 +534,8 @@ private:
 
 	std::ofstream file_;
 	std::ostream *output_;
+
+	std::unique_ptr<AsyncLogWriter> async_;
 };
 
 /**
@@ -100,6 +555,9 @@ int logSetFile(const char *file)
 {
 	Logger *logger = Logger::instance();
 
+	/* Files set explicitly are written synchronously. */
+	logger->async_.reset();
+
 	if (!file) {
 		logger->output_ = &std::cerr;
 		logger->file_.close();
@@ -161,10 +619,24 @@ Logger *Logger::instance()
 
 /**
  * \brief Write a message to the configured logger output
- * \param[in] msg The message string
+ * \param[in] record The message record
+ *
+ * Fatal messages are written synchronously, after all pending messages, to
+ * ensure they reach the log before execution is aborted.
  */
-void Logger::write(const std::string &msg)
+void Logger::write(LogRecord &&record)
 {
+	if (async_) {
+		if (record.severity == LogFatal)
+			async_->writeSync(std::move(record));
+		else
+			async_->write(std::move(record));
+		return;
+	}
+
+	std::string msg;
+	log_format_text(record, &msg);
+
 	output_->write(msg.c_str(), msg.size());
 	output_->flush();
 }
@@ -179,12 +651,20 @@ Logger::Logger()
 	parseLogLevels();
 }
 
+Logger::~Logger()
+{
+	/* Write all pending messages before the writer thread is stopped. */
+	async_.reset();
+}
+
 /**
  * \brief Parse the log output file from the environment
  *
  * If the LIBCAMERA_LOG_FILE environment variable is set, open the file it
- * points to and redirect the logger output to it. Errors are silently ignored
- * and don't affect the logger output (set to stderr).
+ * points to and redirect the logger output to it through an asynchronous
+ * writer, in the format selected by the LIBCAMERA_LOG_FORMAT environment
+ * variable. Errors are silently ignored and don't affect the logger output
+ * (set to stderr).
  */
 void Logger::parseLogFile()
 {
@@ -192,9 +672,18 @@ void Logger::parseLogFile()
 	if (!file)
 		return;
 
-	file_.open(file);
-	if (file_.good())
-		output_ = &file_;
+	int fd = open(file, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+	if (fd < 0)
+		return;
+
+	std::unique_ptr<LogFormatter> formatter;
+	const char *format = utils::secure_getenv("LIBCAMERA_LOG_FORMAT");
+	if (format && !strcmp(format, "binary"))
+		formatter = utils::make_unique<BinaryLogFormatter>();
+	else
+		formatter = utils::make_unique<TextLogFormatter>();
+
+	async_ = utils::make_unique<AsyncLogWriter>(fd, std::move(formatter));
 }
 
 /**
@@ -394,6 +883,17 @@ void LogCategory::setSeverity(LogSeverity severity)
 	severity_ = severity;
 }
 
+/**
+ * \fn LogCategory::enabled()
+ * \brief Check if messages of a given severity are output for the category
+ * \param[in] severity The message severity
+ *
+ * This function is used by the LOG() macro to discard messages before they
+ * are constructed.
+ *
+ * \return True if messages of \a severity are output, false otherwise
+ */
+
 /**
  * \brief Retrieve the default log category
  *
@@ -408,22 +908,6 @@ const LogCategory &LogCategory::defaultCategory()
 	return category;
 }
 
-static const char *log_severity_name(LogSeverity severity)
-{
-	static const char *const names[] = {
-		"  DBG",
-		" INFO",
-		" WARN",
-		"  ERR",
-		"FATAL",
-	};
-
-	if (static_cast<unsigned int>(severity) < ARRAY_SIZE(names))
-		return names[severity];
-	else
-		return "UNKWN";
-}
-
 /**
  * \class LogMessage
  * \brief Internal log message representation.
@@ -485,26 +969,21 @@ LogMessage::LogMessage(const char *fileName, unsigned int line,
  */
 LogMessage::LogMessage(LogMessage &&other)
 	: msgStream_(std::move(other.msgStream_)), category_(other.category_),
-	  severity_(other.severity_)
+	  severity_(other.severity_), fileName_(other.fileName_),
+	  line_(other.line_), timestamp_(other.timestamp_)
 {
 	other.severity_ = LogInvalid;
 }
 
 void LogMessage::init(const char *fileName, unsigned int line)
 {
-	/* Log the timestamp, severity and file information. */
-	struct timespec timestamp;
-	clock_gettime(CLOCK_MONOTONIC, &timestamp);
-	msgStream_.fill('0');
-	msgStream_ << "[" << timestamp.tv_sec / (60 * 60) << ":"
-		   << std::setw(2) << (timestamp.tv_sec / 60) % 60 << ":"
-		   << std::setw(2) << timestamp.tv_sec % 60 << "."
-		   << std::setw(9) << timestamp.tv_nsec << "]";
-	msgStream_.fill(' ');
-
-	msgStream_ << " " << log_severity_name(severity_);
-	msgStream_ << " " << category_.name();
-	msgStream_ << " " << utils::basename(fileName) << ":" << line << " ";
+	/*
+	 * Record the timestamp and file information, they are formatted by
+	 * the logger output.
+	 */
+	timestamp_ = utils::clock_monotonic();
+	fileName_ = fileName;
+	line_ = line;
 }
 
 LogMessage::~LogMessage()
@@ -513,11 +992,16 @@ LogMessage::~LogMessage()
 	if (severity_ == LogInvalid)
 		return;
 
-	msgStream_ << std::endl;
-
 	if (severity_ >= category_.severity()) {
-		std::string msg(msgStream_.str());
-		Logger::instance()->write(msg);
+		LogRecord record = {
+			timestamp_,
+			category_.name(),
+			severity_,
+			fileName_,
+			line_,
+			msgStream_.str(),
+		};
+		Logger::instance()->write(std::move(record));
 	}
 
 	if (severity_ == LogSeverity::LogFatal)
@@ -676,6 +1160,11 @@ LogMessage _log(const char *fileName, unsigned int line,
  * absent the default category is used. The  \a severity controls whether the
  * message is printed or discarded, depending on the log level for the category.
  *
+ * The severity is checked before the message is constructed. When the message
+ * is discarded, the expressions streamed to it are not evaluated, and the
+ * cost of the LOG() statement is limited to the severity check. Expressions
+ * streamed to LOG() shall thus not have side effects.
+ *
  * If the severity is set to Fatal, execution is aborted and the program
  * terminates immediately after printing the message.
  */
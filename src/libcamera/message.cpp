@@ -7,6 +7,9 @@
 
 #include "message.h"
 
+#include <atomic>
+#include <new>
+
 #include "log.h"
 
 /**
@@ -25,6 +28,10 @@
  * The message is delivered in the context of the object's thread, through the
  * Object::message() virtual method. After delivery the message is
  * automatically deleted.
+ *
+ * Messages are allocated from per-thread pools by the MessageAllocator, so
+ * that posting messages doesn't allocate memory from the heap once the pools
+ * have been populated.
  */
 
 namespace libcamera {
@@ -48,7 +55,7 @@ LOG_DEFINE_CATEGORY(Message)
  * \param[in] type The message type
  */
 Message::Message(Message::Type type)
-	: type_(type)
+	: type_(type), receiver_(nullptr), next_(nullptr)
 {
 }
 
@@ -56,6 +63,25 @@ Message::~Message()
 {
 }
 
+/**
+ * \brief Allocate memory for a message from the current thread's pool
+ * \param[in] size The message size
+ * \return A pointer to the allocated memory
+ */
+void *Message::operator new(std::size_t size)
+{
+	return MessageAllocator::allocate(size);
+}
+
+/**
+ * \brief Return the memory of a message to the pool it was allocated from
+ * \param[in] ptr The message memory
+ */
+void Message::operator delete(void *ptr)
+{
+	MessageAllocator::free(ptr);
+}
+
 /**
  * \fn Message::type()
  * \brief Retrieve the message type
@@ -90,4 +116,177 @@ Message::~Message()
  * \brief The signal arguments
  */
 
+namespace {
+
+struct MessagePool;
+
+/*
+ * A memory block managed by a message pool. The header is padded to preserve
+ * the fundamental alignment of the payload.
+ */
+struct alignas(alignof(std::max_align_t)) MessageBlock {
+	MessagePool *pool;
+	MessageBlock *next;
+};
+
+struct MessagePool {
+	MessagePool()
+		: refs(1), free(nullptr), returned(nullptr)
+	{
+	}
+
+	~MessagePool()
+	{
+		deleteBlocks(free);
+		deleteBlocks(returned.load(std::memory_order_acquire));
+	}
+
+	static void deleteBlocks(MessageBlock *block)
+	{
+		while (block) {
+			MessageBlock *next = block->next;
+			::operator delete(block);
+			block = next;
+		}
+	}
+
+	void release()
+	{
+		if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			delete this;
+	}
+
+	/*
+	 * The pool is referenced by its thread and by every block allocated
+	 * from it and not freed yet.
+	 */
+	std::atomic<unsigned int> refs;
+	/* Free blocks, only accessed by the thread owning the pool. */
+	MessageBlock *free;
+	/* Blocks freed by other threads, accessed by all threads. */
+	std::atomic<MessageBlock *> returned;
+};
+
+/*
+ * The pool is stored in a trivially destructible thread-local variable, which
+ * remains accessible for the whole lifetime of the thread. The pool is released
+ * by a separate thread-local holder when the thread exits, after which memory
+ * is allocated from the heap directly.
+ */
+thread_local MessagePool *currentPool = nullptr;
+thread_local bool currentPoolReleased = false;
+
+struct MessagePoolHolder {
+	MessagePoolHolder()
+	{
+		currentPool = new MessagePool();
+	}
+
+	~MessagePoolHolder()
+	{
+		currentPool->release();
+		currentPool = nullptr;
+		currentPoolReleased = true;
+	}
+};
+
+MessagePool *threadPool()
+{
+	if (!currentPool && !currentPoolReleased)
+		static thread_local MessagePoolHolder holder;
+
+	return currentPool;
+}
+
+} /* namespace */
+
+/**
+ * \class MessageAllocator
+ * \brief Allocator for messages and signal argument packs
+ *
+ * The MessageAllocator manages one pool of fixed-size memory blocks per thread.
+ * Memory is allocated from the pool of the allocating thread, and returned to
+ * that pool when freed, regardless of the thread that frees it. Freed blocks
+ * are reused for subsequent allocations, so the steady-state exchange of
+ * messages between threads doesn't allocate memory from the heap.
+ *
+ * Allocation only accesses the pool from its thread, without locking. Blocks
+ * freed by other threads are pushed to the pool with an atomic compare and
+ * swap, and collected all at once by the pool's thread when it runs out of
+ * free blocks.
+ *
+ * Allocations larger than BlockSize are served from the heap.
+ */
+
+/**
+ * \var MessageAllocator::BlockSize
+ * \brief The size of the memory blocks managed by the pools
+ */
+
+/**
+ * \brief Allocate memory
+ * \param[in] size The memory size in bytes
+ * \return A pointer to the allocated memory, suitably aligned for any
+ * fundamental type
+ */
+void *MessageAllocator::allocate(std::size_t size)
+{
+	MessagePool *pool = size <= BlockSize ? threadPool() : nullptr;
+	MessageBlock *block = nullptr;
+
+	if (pool) {
+		block = pool->free;
+		if (!block)
+			block = pool->returned.exchange(nullptr,
+							std::memory_order_acquire);
+		if (block)
+			pool->free = block->next;
+		else
+			block = static_cast<MessageBlock *>(::operator new(sizeof(MessageBlock) + BlockSize));
+
+		pool->refs.fetch_add(1, std::memory_order_relaxed);
+	} else {
+		block = static_cast<MessageBlock *>(::operator new(sizeof(MessageBlock) + size));
+	}
+
+	block->pool = pool;
+	block->next = nullptr;
+
+	return block + 1;
+}
+
+/**
+ * \brief Free memory allocated with allocate()
+ * \param[in] mem The memory
+ *
+ * This method may be called from any thread.
+ */
+void MessageAllocator::free(void *mem)
+{
+	if (!mem)
+		return;
+
+	MessageBlock *block = static_cast<MessageBlock *>(mem) - 1;
+	MessagePool *pool = block->pool;
+
+	if (!pool) {
+		::operator delete(block);
+		return;
+	}
+
+	if (pool == currentPool) {
+		block->next = pool->free;
+		pool->free = block;
+	} else {
+		MessageBlock *head = pool->returned.load(std::memory_order_relaxed);
+		do {
+			block->next = head;
+		} while (!pool->returned.compare_exchange_weak(head, block,
+							       std::memory_order_release,
+							       std::memory_order_relaxed));
+	}
+
+	pool->release();
+}
+
 }; /* namespace libcamera */
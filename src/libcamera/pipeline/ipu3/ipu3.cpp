@@ -21,6 +21,7 @@
 #include "log.h"
 #include "media_device.h"
 #include "pipeline_handler.h"
+#include "trace.h"
 #include "utils.h"
 #include "v4l2_controls.h"
 #include "v4l2_subdevice.h"
@@ -213,12 +214,17 @@ public:
 			    const std::set<Stream *> &streams) override;
 	int freeBuffers(Camera *camera,
 			const std::set<Stream *> &streams) override;
+	int addBuffers(Camera *camera, Stream *stream,
+		       unsigned int count) override;
 
 	int start(Camera *camera) override;
 	void stop(Camera *camera) override;
 
 	int queueRequest(Camera *camera, Request *request) override;
 
+	StreamStatistics streamStatistics(Camera *camera,
+					  Stream *stream) override;
+
 	bool match(DeviceEnumerator *enumerator) override;
 
 private:
@@ -675,6 +681,18 @@ int PipelineHandlerIPU3::freeBuffers(Camera *camera,
 	return 0;
 }
 
+/*
+ * Only the ImgU output buffers of the stream are added. The CIO2 and ImgU
+ * input buffers are internal to the pipeline and keep their number.
+ */
+int PipelineHandlerIPU3::addBuffers(Camera *camera, Stream *stream,
+				    unsigned int count)
+{
+	IPU3Stream *ipu3Stream = static_cast<IPU3Stream *>(stream);
+
+	return ipu3Stream->device_->dev->addBuffers(count);
+}
+
 int PipelineHandlerIPU3::start(Camera *camera)
 {
 	IPU3CameraData *data = cameraData(camera);
@@ -735,6 +753,25 @@ int PipelineHandlerIPU3::queueRequest(Camera *camera, Request *request)
 	return error;
 }
 
+StreamStatistics PipelineHandlerIPU3::streamStatistics(Camera *camera,
+						       Stream *stream)
+{
+	IPU3CameraData *data = cameraData(camera);
+	IPU3Stream *ipu3Stream = static_cast<IPU3Stream *>(stream);
+
+	if (!ipu3Stream->device_)
+		return {};
+
+	StreamStatistics stats = ipu3Stream->device_->dev->statistics();
+
+	/* Frames dropped or corrupted by the CIO2 are lost for all streams. */
+	const StreamStatistics &cio2Stats = data->cio2_.output_->statistics();
+	stats.droppedFrames += cio2Stats.droppedFrames;
+	stats.errors += cio2Stats.errors;
+
+	return stats;
+}
+
 bool PipelineHandlerIPU3::match(DeviceEnumerator *enumerator)
 {
 	int ret;
@@ -913,6 +950,8 @@ int PipelineHandlerIPU3::registerCameras()
  */
 void IPU3CameraData::imguInputBufferReady(Buffer *buffer)
 {
+	TRACE_SCOPE(Pipeline, "IPU3CameraData::imguInputBufferReady");
+
 	cio2_.output_->queueBuffer(buffer);
 }
 
@@ -924,6 +963,8 @@ void IPU3CameraData::imguInputBufferReady(Buffer *buffer)
  */
 void IPU3CameraData::imguOutputBufferReady(Buffer *buffer)
 {
+	TRACE_SCOPE(Pipeline, "IPU3CameraData::imguOutputBufferReady");
+
 	Request *request = buffer->request();
 
 	if (!pipe_->completeBuffer(camera_, request, buffer))
@@ -943,6 +984,8 @@ void IPU3CameraData::imguOutputBufferReady(Buffer *buffer)
  */
 void IPU3CameraData::cio2BufferReady(Buffer *buffer)
 {
+	TRACE_SCOPE(Pipeline, "IPU3CameraData::cio2BufferReady");
+
 	imgu_->input_->queueBuffer(buffer);
 }
 
@@ -22,6 +22,7 @@
 #include "log.h"
 #include "media_device.h"
 #include "pipeline_handler.h"
+#include "trace.h"
 #include "utils.h"
 #include "v4l2_subdevice.h"
 #include "v4l2_videodevice.h"
@@ -84,12 +85,17 @@ public:
 		const std::set<Stream *> &streams) override;
 	int freeBuffers(Camera *camera,
 		const std::set<Stream *> &streams) override;
+	int addBuffers(Camera *camera, Stream *stream,
+		       unsigned int count) override;
 
 	int start(Camera *camera) override;
 	void stop(Camera *camera) override;
 
 	int queueRequest(Camera *camera, Request *request) override;
 
+	StreamStatistics streamStatistics(Camera *camera,
+					  Stream *stream) override;
+
 	bool match(DeviceEnumerator *enumerator) override;
 
 private:
@@ -335,6 +341,12 @@ int PipelineHandlerRkISP1::freeBuffers(Camera *camera,
 	return 0;
 }
 
+int PipelineHandlerRkISP1::addBuffers(Camera *camera, Stream *stream,
+				      unsigned int count)
+{
+	return video_->addBuffers(count);
+}
+
 int PipelineHandlerRkISP1::start(Camera *camera)
 {
 	int ret;
@@ -382,6 +394,12 @@ int PipelineHandlerRkISP1::queueRequest(Camera *camera, Request *request)
 	return 0;
 }
 
+StreamStatistics PipelineHandlerRkISP1::streamStatistics(Camera *camera,
+							 Stream *stream)
+{
+	return video_->statistics();
+}
+
 /* -----------------------------------------------------------------------------
  * Match and Setup
  */
@@ -492,6 +510,8 @@ bool PipelineHandlerRkISP1::match(DeviceEnumerator *enumerator)
 
 void PipelineHandlerRkISP1::bufferReady(Buffer *buffer)
 {
+	TRACE_SCOPE(Pipeline, "PipelineHandlerRkISP1::bufferReady");
+
 	ASSERT(activeCamera_);
 	Request *request = buffer->request();
 
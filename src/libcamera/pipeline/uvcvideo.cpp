@@ -18,6 +18,7 @@
 #include "log.h"
 #include "media_device.h"
 #include "pipeline_handler.h"
+#include "trace.h"
 #include "utils.h"
 #include "v4l2_controls.h"
 #include "v4l2_videodevice.h"
@@ -67,12 +68,17 @@ public:
 			    const std::set<Stream *> &streams) override;
 	int freeBuffers(Camera *camera,
 			const std::set<Stream *> &streams) override;
+	int addBuffers(Camera *camera, Stream *stream,
+		       unsigned int count) override;
 
 	int start(Camera *camera) override;
 	void stop(Camera *camera) override;
 
 	int queueRequest(Camera *camera, Request *request) override;
 
+	StreamStatistics streamStatistics(Camera *camera,
+					  Stream *stream) override;
+
 	bool match(DeviceEnumerator *enumerator) override;
 
 private:
@@ -213,6 +219,13 @@ int PipelineHandlerUVC::freeBuffers(Camera *camera,
 	return data->video_->releaseBuffers();
 }
 
+int PipelineHandlerUVC::addBuffers(Camera *camera, Stream *stream,
+				    unsigned int count)
+{
+	UVCCameraData *data = cameraData(camera);
+	return data->video_->addBuffers(count);
+}
+
 int PipelineHandlerUVC::start(Camera *camera)
 {
 	UVCCameraData *data = cameraData(camera);
@@ -299,6 +312,13 @@ int PipelineHandlerUVC::queueRequest(Camera *camera, Request *request)
 	return 0;
 }
 
+StreamStatistics PipelineHandlerUVC::streamStatistics(Camera *camera,
+						      Stream *stream)
+{
+	UVCCameraData *data = cameraData(camera);
+	return data->video_->statistics();
+}
+
 bool PipelineHandlerUVC::match(DeviceEnumerator *enumerator)
 {
 	MediaDevice *media;
@@ -384,6 +404,8 @@ int UVCCameraData::init(MediaEntity *entity)
 
 void UVCCameraData::bufferReady(Buffer *buffer)
 {
+	TRACE_SCOPE(Pipeline, "UVCCameraData::bufferReady");
+
 	Request *request = buffer->request();
 
 	pipe_->completeBuffer(camera_, request, buffer);
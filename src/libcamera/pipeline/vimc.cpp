@@ -23,6 +23,7 @@
 #include "log.h"
 #include "media_device.h"
 #include "pipeline_handler.h"
+#include "trace.h"
 #include "utils.h"
 #include "v4l2_controls.h"
 #include "v4l2_videodevice.h"
@@ -74,12 +75,17 @@ public:
 			    const std::set<Stream *> &streams) override;
 	int freeBuffers(Camera *camera,
 			const std::set<Stream *> &streams) override;
+	int addBuffers(Camera *camera, Stream *stream,
+		       unsigned int count) override;
 
 	int start(Camera *camera) override;
 	void stop(Camera *camera) override;
 
 	int queueRequest(Camera *camera, Request *request) override;
 
+	StreamStatistics streamStatistics(Camera *camera,
+					  Stream *stream) override;
+
 	bool match(DeviceEnumerator *enumerator) override;
 
 private:
@@ -215,6 +221,13 @@ int PipelineHandlerVimc::freeBuffers(Camera *camera,
 	return data->video_->releaseBuffers();
 }
 
+int PipelineHandlerVimc::addBuffers(Camera *camera, Stream *stream,
+				     unsigned int count)
+{
+	VimcCameraData *data = cameraData(camera);
+	return data->video_->addBuffers(count);
+}
+
 int PipelineHandlerVimc::start(Camera *camera)
 {
 	VimcCameraData *data = cameraData(camera);
@@ -292,6 +305,13 @@ int PipelineHandlerVimc::queueRequest(Camera *camera, Request *request)
 	return 0;
 }
 
+StreamStatistics PipelineHandlerVimc::streamStatistics(Camera *camera,
+						       Stream *stream)
+{
+	VimcCameraData *data = cameraData(camera);
+	return data->video_->statistics();
+}
+
 bool PipelineHandlerVimc::match(DeviceEnumerator *enumerator)
 {
 	DeviceMatch dm("vimc");
@@ -378,6 +398,8 @@ int VimcCameraData::init(MediaDevice *media)
 
 void VimcCameraData::bufferReady(Buffer *buffer)
 {
+	TRACE_SCOPE(Pipeline, "VimcCameraData::bufferReady");
+
 	Request *request = buffer->request();
 
 	pipe_->completeBuffer(camera_, request, buffer);
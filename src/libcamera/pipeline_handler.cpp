@@ -7,6 +7,8 @@
 
 #include "pipeline_handler.h"
 
+#include <errno.h>
+
 #include <libcamera/buffer.h>
 #include <libcamera/camera.h>
 #include <libcamera/camera_manager.h>
@@ -84,6 +86,9 @@ LOG_DEFINE_CATEGORY(Pipeline)
  * The list of queued request is used to track requests queued in order to
  * ensure completion of all requests when the pipeline handler is stopped.
  *
+ * The list is stored in a vector, as the number of requests in flight is
+ * small, to avoid allocating memory for every queued request.
+ *
  * \sa PipelineHandler::queueRequest(), PipelineHandler::stop(),
  * PipelineHandler::completeRequest()
  */
@@ -236,6 +241,25 @@ const ControlInfoMap &PipelineHandler::controls(Camera *camera)
 	return data->controlInfo_;
 }
 
+/**
+ * \brief Retrieve the frame delivery statistics of a camera
+ * \param[in] camera The camera
+ *
+ * Aggregate the statistics of all the streams of the \a camera, as reported by
+ * streamStatistics().
+ *
+ * \return A map of the \a camera streams to their statistics
+ */
+std::map<Stream *, StreamStatistics> PipelineHandler::statistics(Camera *camera)
+{
+	std::map<Stream *, StreamStatistics> stats;
+
+	for (Stream *stream : camera->streams())
+		stats[stream] = streamStatistics(camera, stream);
+
+	return stats;
+}
+
 /**
  * \fn PipelineHandler::generateConfiguration()
  * \brief Generate a camera configuration for a specified camera
@@ -308,6 +332,30 @@ const ControlInfoMap &PipelineHandler::controls(Camera *camera)
  * \return 0 on success or a negative error code otherwise
  */
 
+/**
+ * \brief Add buffers to a stream
+ * \param[in] camera The camera the \a stream belongs to
+ * \param[in] stream The stream to add buffers to
+ * \param[in] count The number of buffers to add
+ *
+ * This method allocates \a count buffers in addition to the ones allocated by
+ * allocateBuffers(), and associates them with the last \a count buffers of the
+ * stream's buffer pool, which has already been grown by the caller. It may be
+ * called while the camera is running.
+ *
+ * Pipeline handlers that support growing streams shall override this method.
+ * The base implementation returns -ENOTSUP.
+ *
+ * The intended caller of this method is the Camera class.
+ *
+ * \return 0 on success or a negative error code otherwise
+ */
+int PipelineHandler::addBuffers(Camera *camera, Stream *stream,
+				unsigned int count)
+{
+	return -ENOTSUP;
+}
+
 /**
  * \fn PipelineHandler::start()
  * \brief Start capturing from a group of streams
@@ -358,6 +406,25 @@ int PipelineHandler::queueRequest(Camera *camera, Request *request)
 	return 0;
 }
 
+/**
+ * \brief Retrieve the frame delivery statistics of a stream
+ * \param[in] camera The camera the \a stream belongs to
+ * \param[in] stream The stream
+ *
+ * Pipeline handlers shall override this method to report the statistics of
+ * the video devices involved in capturing frames for the \a stream. When
+ * multiple video devices are involved, frames dropped or corrupted by any of
+ * them shall be accounted for. The base implementation returns zeroed
+ * statistics.
+ *
+ * \return The frame delivery statistics of the \a stream
+ */
+StreamStatistics PipelineHandler::streamStatistics(Camera *camera,
+						   Stream *stream)
+{
+	return {};
+}
+
 /**
  * \brief Complete a buffer for a request
  * \param[in] camera The camera the request belongs to
@@ -406,7 +473,7 @@ void PipelineHandler::completeRequest(Camera *camera, Request *request)
 			break;
 
 		ASSERT(!request->hasPendingBuffers());
-		data->queuedRequests_.pop_front();
+		data->queuedRequests_.erase(data->queuedRequests_.begin());
 		camera->requestComplete(request);
 	}
 }
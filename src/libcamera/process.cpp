@@ -45,6 +45,7 @@ class ProcessManager
 {
 public:
 	void registerProcess(Process *proc);
+	void unregisterProcess(Process *proc);
 
 	static ProcessManager *instance();
 
@@ -122,6 +123,18 @@ void ProcessManager::registerProcess(Process *proc)
 	processes_.push_back(proc);
 }
 
+/**
+ * \brief Unregister a process
+ * \param[in] proc Process to unregister
+ *
+ * This method removes a process from the list of processes monitored for
+ * termination. It shall be called when a running process is destroyed.
+ */
+void ProcessManager::unregisterProcess(Process *proc)
+{
+	processes_.remove(proc);
+}
+
 ProcessManager::ProcessManager()
 {
 	sigaction(SIGCHLD, NULL, &oldsa_);
@@ -216,8 +229,13 @@ Process::Process()
 
 Process::~Process()
 {
-	kill();
-	/* \todo wait for child process to exit */
+	if (running_) {
+		ProcessManager::instance()->unregisterProcess(this);
+		kill();
+
+		/* Reap the process, it can't be monitored for termination anymore. */
+		waitpid(pid_, nullptr, 0);
+	}
 }
 
 /**
@@ -264,6 +282,7 @@ int Process::start(const std::string &path,
 		closeAllFdsExcept(fds);
 
 		unsetenv("LIBCAMERA_LOG_FILE");
+		unsetenv("LIBCAMERA_TRACE_FILE");
 
 		const char **argv = new const char *[args.size() + 2];
 		unsigned int len = args.size();
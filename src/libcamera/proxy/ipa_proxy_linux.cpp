@@ -5,16 +5,23 @@
  * ipa_proxy_linux.cpp - Default Image Processing Algorithm proxy for Linux
  */
 
+#include <list>
+#include <map>
+#include <memory>
+#include <unistd.h>
 #include <vector>
 
 #include <libcamera/ipa/ipa_interface.h>
 #include <libcamera/ipa/ipa_module_info.h>
+#include <libcamera/timer.h>
 
 #include "ipa_module.h"
 #include "ipa_proxy.h"
-#include "ipc_unixsocket.h"
+#include "ipc_ring_channel.h"
+#include "ipc_serializer.h"
 #include "log.h"
 #include "process.h"
+#include "utils.h"
 
 namespace libcamera {
 
@@ -27,68 +34,306 @@ public:
 	~IPAProxyLinux();
 
 	int init();
+	void processEvent(const IPAOperationData &event);
+
+	static void prepare(IPAModule *ipam, unsigned int count);
 
 private:
-	void readyRead(IPCUnixSocket *ipc);
+	struct Worker {
+		std::unique_ptr<Process> process;
+		std::unique_ptr<IPCRingChannel> channel;
+	};
+
+	class WorkerPool
+	{
+	public:
+		WorkerPool(const std::string &module);
+
+		void resize(unsigned int size);
+		bool take(Worker *worker);
+
+	private:
+		static constexpr unsigned int RefillDelay = 100;
+
+		void refill();
+		void refillTimeout(Timer *timer);
+
+		std::string module_;
+		unsigned int size_;
+		std::list<Worker> workers_;
+		Timer refillTimer_;
+	};
+
+	static int spawn(const std::string &module, Worker *worker);
+	static std::map<std::string, std::unique_ptr<WorkerPool>> &pools();
 
+	void setWorker(Worker *worker);
+	void readyRead(IPCRingChannel *ipc);
+
+	std::string module_;
+	bool pooled_;
 	Process *proc_;
 
-	IPCUnixSocket *socket_;
+	IPCRingChannel *socket_;
+	std::vector<int32_t> fds_;
+	IPAOperationData action_;
 };
 
 int IPAProxyLinux::init()
 {
-	LOG(IPAProxy, Debug) << "initializing IPA via dummy proxy!";
+	LOG(IPAProxy, Debug) << "initializing IPA via proxy";
 
-	return 0;
+	const uint32_t operation = IPAProxyInit;
+	int ret = socket_->write(operation);
+
+	/*
+	 * A pool worker may have died without having been reaped yet. Failing
+	 * to send the first message to it means it is gone, replace it with a
+	 * new worker.
+	 */
+	if (ret && pooled_) {
+		LOG(IPAProxy, Warning)
+			<< "Pre-spawned worker unreachable, spawning a new one";
+
+		Worker worker;
+		ret = spawn(module_, &worker);
+		if (!ret) {
+			setWorker(&worker);
+			ret = socket_->write(operation);
+		}
+	}
+
+	pooled_ = false;
+
+	return ret;
+}
+
+void IPAProxyLinux::processEvent(const IPAOperationData &event)
+{
+	const uint32_t operation = IPAProxyProcessEvent;
+	int ret = socket_->write(operation, event);
+	if (ret)
+		LOG(IPAProxy, Error)
+			<< "Failed to send event to worker: " << ret;
 }
 
 IPAProxyLinux::IPAProxyLinux(IPAModule *ipam)
+	: module_(ipam->path()), pooled_(false), proc_(nullptr), socket_(nullptr)
 {
 	LOG(IPAProxy, Debug)
-		<< "initializing dummy proxy: loading IPA from "
-		<< ipam->path();
+		<< "initializing proxy: loading IPA from " << ipam->path();
 
-	std::vector<int> fds;
-	std::vector<std::string> args;
-	args.push_back(ipam->path());
+	Worker worker;
+
+	auto iter = pools().find(ipam->path());
+	if (iter != pools().end() && iter->second->take(&worker)) {
+		LOG(IPAProxy, Debug) << "Using pre-spawned worker";
+		pooled_ = true;
+	} else if (spawn(ipam->path(), &worker)) {
+		return;
+	}
+
+	setWorker(&worker);
+
+	valid_ = true;
+}
+
+IPAProxyLinux::~IPAProxyLinux()
+{
+	delete proc_;
+	delete socket_;
+}
+
+/**
+ * \brief Maintain a pool of warm workers for an IPA module
+ * \param[in] ipam The IPA module
+ * \param[in] count The number of workers to keep in the pool
+ *
+ * Spawning a worker and loading the IPA module in it accounts for most of the
+ * proxy creation time. This function starts \a count workers ahead of time,
+ * which are then handed out to new proxies for \a ipam, and replaced as they
+ * get used. Setting \a count to 0 terminates all the pool workers.
+ */
+void IPAProxyLinux::prepare(IPAModule *ipam, unsigned int count)
+{
+	std::map<std::string, std::unique_ptr<WorkerPool>> &pools =
+		IPAProxyLinux::pools();
+
+	if (!count) {
+		pools.erase(ipam->path());
+		return;
+	}
+
+	std::unique_ptr<WorkerPool> &pool = pools[ipam->path()];
+	if (!pool)
+		pool = utils::make_unique<WorkerPool>(ipam->path());
+
+	pool->resize(count);
+
+	LOG(IPAProxy, Debug)
+		<< "Prepared " << count << " workers for " << ipam->path();
+}
+
+int IPAProxyLinux::spawn(const std::string &module, Worker *worker)
+{
 	const std::string path = resolvePath("ipa_proxy_linux");
 	if (path.empty()) {
 		LOG(IPAProxy, Error)
 			<< "Failed to get proxy worker path";
-		return;
+		return -ENOENT;
 	}
 
-	socket_ = new IPCUnixSocket();
-	int fd = socket_->create();
+	std::unique_ptr<IPCRingChannel> channel(new IPCRingChannel());
+	int fd = channel->create();
 	if (fd < 0) {
 		LOG(IPAProxy, Error)
 			<< "Failed to create socket";
-		return;
+		return fd;
 	}
-	socket_->readyRead.connect(this, &IPAProxyLinux::readyRead);
+
+	std::vector<int> fds;
+	std::vector<std::string> args;
+	args.push_back(module);
 	args.push_back(std::to_string(fd));
 	fds.push_back(fd);
 
-	proc_ = new Process();
-	int ret = proc_->start(path, args, fds);
+	std::unique_ptr<Process> process(new Process());
+	int ret = process->start(path, args, fds);
+
+	/* The remote end of the socket now belongs to the worker. */
+	close(fd);
+
 	if (ret) {
 		LOG(IPAProxy, Error)
 			<< "Failed to start proxy worker process";
-		return;
+		return ret;
 	}
 
-	valid_ = true;
+	worker->process = std::move(process);
+	worker->channel = std::move(channel);
+
+	return 0;
 }
 
-IPAProxyLinux::~IPAProxyLinux()
+std::map<std::string, std::unique_ptr<IPAProxyLinux::WorkerPool>> &
+IPAProxyLinux::pools()
+{
+	static std::map<std::string, std::unique_ptr<WorkerPool>> pools;
+	return pools;
+}
+
+void IPAProxyLinux::setWorker(Worker *worker)
 {
 	delete proc_;
 	delete socket_;
+
+	proc_ = worker->process.release();
+	socket_ = worker->channel.release();
+	socket_->readyRead.connect(this, &IPAProxyLinux::readyRead);
+}
+
+/*
+ * The pools outlive the proxies, and refill themselves from the event loop
+ * after handing out a worker, not to delay the proxy creation.
+ */
+IPAProxyLinux::WorkerPool::WorkerPool(const std::string &module)
+	: module_(module), size_(0)
+{
+	refillTimer_.timeout.connect(this, &WorkerPool::refillTimeout);
+}
+
+void IPAProxyLinux::WorkerPool::resize(unsigned int size)
+{
+	size_ = size;
+
+	while (workers_.size() > size_)
+		workers_.pop_back();
+
+	refill();
+}
+
+bool IPAProxyLinux::WorkerPool::take(Worker *worker)
+{
+	/*
+	 * Delay the replacement of the worker handed out, not to compete for
+	 * CPU time with it while it processes its first requests.
+	 */
+	refillTimer_.start(RefillDelay);
+
+	while (!workers_.empty()) {
+		Worker candidate = std::move(workers_.front());
+		workers_.pop_front();
+
+		/* Skip the workers known to have exited. */
+		if (candidate.process->exitStatus() == Process::NotExited) {
+			*worker = std::move(candidate);
+			return true;
+		}
+	}
+
+	return false;
 }
 
-void IPAProxyLinux::readyRead(IPCUnixSocket *ipc)
+void IPAProxyLinux::WorkerPool::refill()
 {
+	while (workers_.size() < size_) {
+		Worker worker;
+		if (spawn(module_, &worker))
+			return;
+		workers_.push_back(std::move(worker));
+	}
+}
+
+void IPAProxyLinux::WorkerPool::refillTimeout(Timer *timer)
+{
+	refill();
+}
+
+void IPAProxyLinux::readyRead(IPCRingChannel *ipc)
+{
+	size_t size;
+	const void *data = ipc->acquire(&size, &fds_);
+	if (!data) {
+		LOG(IPAProxy, Error) << "Failed to receive message from worker";
+		return;
+	}
+
+	IPCDeserializer deserializer(data, size, &fds_);
+	uint32_t operation = 0;
+	uint32_t frame = 0;
+	int32_t ret = 0;
+
+	deserializer.read(&operation);
+
+	switch (operation) {
+	case IPAProxyInit:
+		if (deserializer.read(&ret) && ret)
+			LOG(IPAProxy, Error) << "IPA init failed: " << ret;
+		break;
+
+	case IPAProxyQueueFrameAction:
+		deserializer.read(&frame, &action_);
+		break;
+
+	default:
+		deserializer.fail();
+		break;
+	}
+
+	bool valid = deserializer.valid();
+
+	ipc->release();
+
+	for (int32_t fd : fds_)
+		close(fd);
+
+	if (!valid) {
+		LOG(IPAProxy, Error) << "Malformed message from worker";
+		return;
+	}
+
+	if (operation == IPAProxyQueueFrameAction)
+		queueFrameAction.emit(frame, action_);
 }
 
 REGISTER_IPA_PROXY(IPAProxyLinux)
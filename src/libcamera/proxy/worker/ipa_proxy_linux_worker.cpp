@@ -15,7 +15,9 @@
 #include <libcamera/logging.h>
 
 #include "ipa_module.h"
-#include "ipc_unixsocket.h"
+#include "ipa_proxy.h"
+#include "ipc_ring_channel.h"
+#include "ipc_serializer.h"
 #include "log.h"
 #include "utils.h"
 
@@ -23,19 +25,66 @@ using namespace libcamera;
 
 LOG_DEFINE_CATEGORY(IPAProxyLinuxWorker)
 
-void readyRead(IPCUnixSocket *ipc)
-{
-	IPCUnixSocket::Payload message;
-	int ret;
+static IPAInterface *ipa;
+static IPCRingChannel *channel;
+static std::vector<int32_t> fds;
+static IPAOperationData event;
 
-	ret = ipc->receive(&message);
-	if (ret) {
+void queueFrameAction(unsigned int frame, const IPAOperationData &action)
+{
+	const uint32_t operation = IPAProxyQueueFrameAction;
+	int ret = channel->write(operation, static_cast<uint32_t>(frame), action);
+	if (ret)
 		LOG(IPAProxyLinuxWorker, Error)
-			<< "Receive message failed: " << ret;
+			<< "Failed to send frame action: " << ret;
+}
+
+void readyRead(IPCRingChannel *ipc)
+{
+	size_t size;
+	const void *data = ipc->acquire(&size, &fds);
+	if (!data) {
+		LOG(IPAProxyLinuxWorker, Error) << "Receive message failed";
+		return;
+	}
+
+	/* Arguments are deserialized in place from the ring buffer. */
+	IPCDeserializer deserializer(data, size, &fds);
+	uint32_t operation = 0;
+
+	deserializer.read(&operation);
+	if (operation == IPAProxyProcessEvent)
+		deserializer.read(&event);
+
+	bool valid = deserializer.valid();
+
+	ipc->release();
+
+	for (int32_t fd : fds)
+		close(fd);
+
+	if (!valid) {
+		LOG(IPAProxyLinuxWorker, Error) << "Malformed message";
 		return;
 	}
 
-	LOG(IPAProxyLinuxWorker, Debug) << "Received a message!";
+	switch (operation) {
+	case IPAProxyInit: {
+		int32_t ret = ipa->init();
+		if (channel->write(operation, ret))
+			LOG(IPAProxyLinuxWorker, Error) << "Failed to reply";
+		break;
+	}
+
+	case IPAProxyProcessEvent:
+		ipa->processEvent(event);
+		break;
+
+	default:
+		LOG(IPAProxyLinuxWorker, Error)
+			<< "Unknown operation " << operation;
+		break;
+	}
 }
 
 int main(int argc, char **argv)
@@ -65,19 +114,24 @@ int main(int argc, char **argv)
 		return EXIT_FAILURE;
 	}
 
-	IPCUnixSocket socket;
+	IPCRingChannel socket;
 	if (socket.bind(fd) < 0) {
 		LOG(IPAProxyLinuxWorker, Error) << "IPC socket binding failed";
 		return EXIT_FAILURE;
 	}
-	socket.readyRead.connect(&readyRead);
 
-	std::unique_ptr<IPAInterface> ipa = ipam->createInstance();
-	if (!ipa) {
+	std::unique_ptr<IPAInterface> instance = ipam->createInstance();
+	if (!instance) {
 		LOG(IPAProxyLinuxWorker, Error) << "Failed to create IPA interface";
 		return EXIT_FAILURE;
 	}
 
+	ipa = instance.get();
+	ipa->queueFrameAction.connect(&queueFrameAction);
+
+	channel = &socket;
+	socket.readyRead.connect(&readyRead);
+
 	LOG(IPAProxyLinuxWorker, Debug) << "Proxy worker successfully started";
 
 	/* \todo upgrade listening loop */
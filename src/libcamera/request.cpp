@@ -7,8 +7,6 @@
 
 #include <libcamera/request.h>
 
-#include <map>
-
 #include <libcamera/buffer.h>
 #include <libcamera/camera.h>
 #include <libcamera/stream.h>
@@ -35,12 +33,129 @@ LOG_DEFINE_CATEGORY(Request)
  * The request has been cancelled due to capture stop
  */
 
+/**
+ * \var Request::MaxBuffers
+ * \brief The maximum number of buffers, one per stream, that a request can
+ * contain
+ */
+
+/**
+ * \enum Request::TracePoint
+ * \brief The stages of a request's processing that are timestamped when tracing
+ * is enabled on the camera
+ * \var Request::TraceQueued
+ * The request has been queued to the camera by the application
+ * \var Request::TracePipelineQueued
+ * The request has been validated and passed to the pipeline handler
+ * \var Request::TraceDeviceQueued
+ * The first buffer of the request has been queued to its video device
+ * \var Request::TraceDeviceDequeued
+ * The last buffer of the request has been dequeued from its video device
+ * \var Request::TraceCompleted
+ * The request completion is about to be signalled to the application
+ * \var Request::TracePointCount
+ * The number of trace points
+ */
+
+/**
+ * \class Request::BufferMap
+ * \brief Map of streams to buffers contained in a request
+ *
+ * The BufferMap associates each stream in a request with the buffer the stream
+ * output is directed to. As cameras only expose a handful of streams, the map
+ * stores up to MaxBuffers entries inline in insertion order and looks them up
+ * linearly, avoiding memory allocation on the per-frame request handling path.
+ *
+ * The map is iterated as a sequence of std::pair<Stream *, Buffer *> entries,
+ * similarly to a std::map.
+ */
+
+/**
+ * \typedef Request::BufferMap::value_type
+ * \brief The type of the map entries, a pair of stream and buffer pointers
+ */
+
+/**
+ * \typedef Request::BufferMap::const_iterator
+ * \brief Iterator over the map entries
+ */
+
+/**
+ * \fn Request::BufferMap::begin()
+ * \brief Retrieve an iterator to the first entry in the map
+ * \return An iterator to the first entry in the map
+ */
+
+/**
+ * \fn Request::BufferMap::end()
+ * \brief Retrieve an iterator pointing to the past-the-end entry in the map
+ * \return An iterator to the element following the last entry in the map
+ */
+
+/**
+ * \brief Find the entry for a stream
+ * \param[in] stream The stream to search for
+ * \return An iterator to the entry for \a stream, or end() if the stream isn't
+ * part of the map
+ */
+Request::BufferMap::const_iterator Request::BufferMap::find(Stream *stream) const
+{
+	for (const_iterator it = begin(); it != end(); ++it) {
+		if (it->first == stream)
+			return it;
+	}
+
+	return end();
+}
+
+/**
+ * \fn Request::BufferMap::empty()
+ * \brief Check if the map is empty
+ * \return True if the map contains no entry, false otherwise
+ */
+
+/**
+ * \fn Request::BufferMap::size()
+ * \brief Retrieve the number of entries in the map
+ * \return The number of entries in the map
+ */
+
+/**
+ * \brief Add an entry to the map
+ * \param[in] stream The stream
+ * \param[in] buffer The buffer associated with the \a stream
+ *
+ * The caller is responsible for ensuring that the map doesn't already contain
+ * an entry for the \a stream.
+ *
+ * \return True if the entry has been added, false if the map is full
+ */
+bool Request::BufferMap::insert(Stream *stream, Buffer *buffer)
+{
+	if (size_ == MaxBuffers)
+		return false;
+
+	entries_[size_++] = { stream, buffer };
+	return true;
+}
+
+/**
+ * \fn Request::BufferMap::clear()
+ * \brief Remove all entries from the map
+ */
+
 /**
  * \class Request
  * \brief A frame capture request
  *
  * A Request allows an application to associate buffers and controls on a
  * per-frame basis to be queued to the camera device for processing.
+ *
+ * Requests are deleted by the camera once they complete, unless the
+ * application claims them back with reuse() from the completion handler. A
+ * reused request keeps its buffers and controls and can be queued again
+ * without any memory allocation, which is the recommended way to run a
+ * continuous capture.
  */
 
 /**
@@ -55,8 +170,8 @@ LOG_DEFINE_CATEGORY(Request)
  *
  */
 Request::Request(Camera *camera, uint64_t cookie)
-	: camera_(camera), controls_(camera), cookie_(cookie),
-	  status_(RequestPending), cancelled_(false)
+	: camera_(camera), controls_(camera), pendingCount_(0), cookie_(cookie),
+	  status_(RequestPending), cancelled_(false), trace_{}
 {
 }
 
@@ -103,10 +218,12 @@ Request::~Request()
  *
  * A request can only contain one buffer per stream. If a buffer has already
  * been added to the request for the same stream, this method returns -EEXIST.
+ * A request can contain at most MaxBuffers buffers.
  *
  * \return 0 on success or a negative error code otherwise
  * \retval -EEXIST The request already contains a buffer for the stream
  * \retval -EINVAL The buffer does not reference a valid Stream
+ * \retval -ENOSPC The request already contains MaxBuffers buffers
  */
 int Request::addBuffer(std::unique_ptr<Buffer> buffer)
 {
@@ -122,7 +239,12 @@ int Request::addBuffer(std::unique_ptr<Buffer> buffer)
 		return -EEXIST;
 	}
 
-	bufferMap_[stream] = buffer.release();
+	if (!bufferMap_.insert(stream, buffer.get())) {
+		LOG(Request, Error) << "Too many buffers in request";
+		return -ENOSPC;
+	}
+
+	buffer.release();
 
 	return 0;
 }
@@ -151,6 +273,31 @@ Buffer *Request::findBuffer(Stream *stream) const
 	return it->second;
 }
 
+/**
+ * \brief Reuse a completed request
+ *
+ * This method shall be called from the Camera::requestCompleted signal handler
+ * to prevent the camera from deleting the request once the handler returns.
+ * Ownership of the request is transferred back to the application, and the
+ * request is reset to the RequestPending status. Its buffers, controls and
+ * cookie are preserved.
+ *
+ * The request can then be queued again with Camera::queueRequest(), either
+ * from within the completion handler or at a later time. If the application
+ * doesn't queue the request, it is responsible for deleting it.
+ */
+void Request::reuse()
+{
+	ASSERT(status_ != RequestPending);
+
+	status_ = RequestPending;
+	cancelled_ = false;
+
+	/* Prevent the camera from recycling the request. */
+	if (camera_->completedRequest_ == this)
+		camera_->completedRequest_ = nullptr;
+}
+
 /**
  * \fn Request::cookie()
  * \brief Retrieve the cookie set when the request was created
@@ -170,6 +317,18 @@ Buffer *Request::findBuffer(Stream *stream) const
  * \return The request completion status
  */
 
+/**
+ * \fn Request::traceTimestamp()
+ * \brief Retrieve the time at which the request reached a trace point
+ * \param[in] point The trace point
+ *
+ * Timestamps are recorded with the monotonic clock when tracing is enabled with
+ * Camera::setTracing(). Trace points that haven't been reached, or that the
+ * pipeline handler doesn't support, are set to 0.
+ *
+ * \return The trace point timestamp in nanoseconds, or 0 if not available
+ */
+
 /**
  * \fn Request::hasPendingBuffers()
  * \brief Check if a request has buffers yet to be completed
@@ -193,10 +352,11 @@ int Request::prepare()
 		return -EINVAL;
 	}
 
+	pendingCount_ = 0;
 	for (auto const &pair : bufferMap_) {
 		Buffer *buffer = pair.second;
 		buffer->setRequest(this);
-		pending_.insert(buffer);
+		pending_[pendingCount_++] = buffer;
 	}
 
 	return 0;
@@ -215,6 +375,29 @@ void Request::complete()
 	status_ = cancelled_ ? RequestCancelled : RequestComplete;
 }
 
+/**
+ * \brief Reset the request to its initial state
+ *
+ * Delete all buffers and controls from the request and reset its cookie and
+ * status, in order to recycle the request object for a new capture.
+ */
+void Request::reset()
+{
+	for (auto it : bufferMap_) {
+		Buffer *buffer = it.second;
+		delete buffer;
+	}
+
+	bufferMap_.clear();
+	pendingCount_ = 0;
+	controls_.clear();
+
+	cookie_ = 0;
+	status_ = RequestPending;
+	cancelled_ = false;
+	trace_.fill(0);
+}
+
 /**
  * \brief Complete a buffer for the request
  * \param[in] buffer The buffer that has completed
@@ -230,14 +413,35 @@ void Request::complete()
  */
 bool Request::completeBuffer(Buffer *buffer)
 {
-	int ret = pending_.erase(buffer);
-	ASSERT(ret == 1);
+	unsigned int index;
+	for (index = 0; index < pendingCount_; ++index) {
+		if (pending_[index] == buffer)
+			break;
+	}
+
+	ASSERT(index < pendingCount_);
+	pending_[index] = pending_[--pendingCount_];
 
 	buffer->setRequest(nullptr);
 
 	if (buffer->status() == Buffer::BufferCancelled)
 		cancelled_ = true;
 
+	/*
+	 * The request reaches the device when its first buffer is queued, and
+	 * leaves it when its last buffer is dequeued.
+	 */
+	if (buffer->traced_) {
+		uint64_t &queued = trace_[TraceDeviceQueued];
+		uint64_t &dequeued = trace_[TraceDeviceDequeued];
+
+		if (buffer->traceQueued_ &&
+		    (!queued || buffer->traceQueued_ < queued))
+			queued = buffer->traceQueued_;
+		if (buffer->traceDequeued_ > dequeued)
+			dequeued = buffer->traceDequeued_;
+	}
+
 	return !hasPendingBuffers();
 }
 
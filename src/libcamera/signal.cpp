@@ -63,6 +63,21 @@ void SlotBase::disconnect(SignalBase *signal)
 		object_->disconnect(signal);
 }
 
+/*
+ * Argument packs for cross-thread signal delivery are allocated from the same
+ * per-thread pools as messages, to avoid heap allocations when emitting
+ * signals.
+ */
+void *SlotBase::allocatePack(std::size_t size)
+{
+	return MessageAllocator::allocate(size);
+}
+
+void SlotBase::freePack(void *pack)
+{
+	MessageAllocator::free(pack);
+}
+
 void SlotBase::activatePack(void *pack)
 {
 	Object *obj = static_cast<Object *>(object_);
@@ -128,6 +143,15 @@ void SlotBase::activatePack(void *pack)
  * function are passed to the slot functions unchanged. If a slot modifies one
  * of the arguments (when passed by pointer or reference), the modification is
  * thus visible to all subsequently called slots.
+ *
+ * Slots may connect and disconnect slots from within the emission. Slots
+ * connected during emission will only be called for subsequent emissions, and
+ * slots disconnected during emission will not be called anymore, even if they
+ * haven't been reached yet by the current emission.
+ *
+ * A slot may also delete the signal, for instance when the signal belongs to
+ * an object destroyed by the slot. The emission then stops without calling
+ * the remaining slots.
  */
 
 } /* namespace libcamera */
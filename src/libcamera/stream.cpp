@@ -10,8 +10,13 @@
 #include <algorithm>
 #include <array>
 #include <climits>
+#include <errno.h>
 #include <iomanip>
 #include <sstream>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <libcamera/request.h>
 
@@ -41,6 +46,31 @@ namespace libcamera {
 
 LOG_DEFINE_CATEGORY(Stream)
 
+namespace {
+
+/*
+ * Before Linux v5.3, dmabufs were backed by the anonymous inode shared by all
+ * anon_inode files, and their inode numbers can't tell them apart. Retrieve the
+ * identity of that inode through an eventfd, which is always backed by it.
+ */
+std::pair<dev_t, ino_t> anonInodeIdentity()
+{
+	std::pair<dev_t, ino_t> identity{};
+
+	int fd = eventfd(0, EFD_CLOEXEC);
+	if (fd < 0)
+		return identity;
+
+	struct stat st;
+	if (!fstat(fd, &st))
+		identity = { st.st_dev, st.st_ino };
+
+	close(fd);
+	return identity;
+}
+
+} /* namespace */
+
 /**
  * \class StreamFormats
  * \brief Hold information about supported stream formats
@@ -276,6 +306,36 @@ SizeRange StreamFormats::range(unsigned int pixelformat) const
  * the library.
  */
 
+/**
+ * \struct StreamStatistics
+ * \brief Frame delivery statistics for a stream
+ *
+ * The statistics are accumulated from the creation of the camera, across all
+ * capture sessions. They allow telling frames lost because the application
+ * didn't provide buffers in time from frames lost or corrupted by the device.
+ *
+ * \var StreamStatistics::frames
+ * \brief The number of frames completed by the device, including erroneous
+ * ones
+ *
+ * \var StreamStatistics::droppedFrames
+ * \brief The number of frames dropped by the device, detected as gaps in the
+ * frame sequence numbers
+ *
+ * \var StreamStatistics::underrunTime
+ * \brief The cumulated time in nanoseconds during which the device was
+ * streaming without any buffer queued
+ *
+ * Frames dropped while the device is underrun are caused by the application
+ * not queuing buffers fast enough.
+ *
+ * \var StreamStatistics::errors
+ * \brief The number of frames completed with an error
+ *
+ * \var StreamStatistics::cancelled
+ * \brief The number of buffers cancelled when stopping the device
+ */
+
 /**
  * \struct StreamConfiguration
  * \brief Configuration parameters for a stream
@@ -289,7 +349,7 @@ SizeRange StreamFormats::range(unsigned int pixelformat) const
  * handlers provied StreamFormats.
  */
 StreamConfiguration::StreamConfiguration()
-	: memoryType(InternalMemory), stream_(nullptr)
+	: memoryType(InternalMemory), maxBufferCount(0), stream_(nullptr)
 {
 }
 
@@ -297,7 +357,8 @@ StreamConfiguration::StreamConfiguration()
  * \brief Construct a configuration with stream formats
  */
 StreamConfiguration::StreamConfiguration(const StreamFormats &formats)
-	: memoryType(InternalMemory), stream_(nullptr), formats_(formats)
+	: memoryType(InternalMemory), maxBufferCount(0), stream_(nullptr),
+	  formats_(formats)
 {
 }
 
@@ -324,6 +385,15 @@ StreamConfiguration::StreamConfiguration(const StreamFormats &formats)
  * \brief Requested number of buffers to allocate for the stream
  */
 
+/**
+ * \var StreamConfiguration::maxBufferCount
+ * \brief Maximum number of buffers the stream can grow to
+ *
+ * Buffers can be added to the stream at runtime with Camera::addBuffers(), up
+ * to a total of \a maxBufferCount buffers. The default value of 0, or any value
+ * lower than \a bufferCount, disables growing the stream.
+ */
+
 /**
  * \fn StreamConfiguration::stream()
  * \brief Retrieve the stream associated with the configuration
@@ -422,6 +492,7 @@ std::string StreamConfiguration::toString() const
  * \brief Construct a stream with default parameters
  */
 Stream::Stream()
+	: memoryType_(InternalMemory)
 {
 }
 
@@ -504,6 +575,9 @@ std::unique_ptr<Buffer> Stream::createBuffer(const std::array<int, 3> &fds)
  * stream. It is initially created empty and shall be populated with
  * buffers before being used.
  *
+ * The pool mapping policy controls how the memory of the stream buffers is
+ * mapped to the CPU, including for buffers imported with ExternalMemory.
+ *
  * \return A reference to the buffer pool
  */
 
@@ -536,9 +610,20 @@ std::unique_ptr<Buffer> Stream::createBuffer(const std::array<int, 3> &fds)
  * The buffer memory to use, once the \a buffer reaches the video device,
  * is selected using the index assigned to the \a buffer and to minimize
  * relocations in the V4L2 back-end, this operation provides a best-effort
- * caching mechanism that associates to the dmabuf file descriptors contained
- * in the \a buffer the index of the buffer memory that was lastly queued with
- * those file descriptors set.
+ * caching mechanism that associates to the dmabuf objects referenced by the
+ * \a buffer the index of the buffer memory that was lastly queued with those
+ * dmabuf objects.
+ *
+ * dmabuf objects are identified by the device and inode numbers of their file
+ * descriptors, as file descriptor numbers may differ for the same dmabuf, or be
+ * reused for a different dmabuf after being closed. When the same dmabuf
+ * objects are queued again, the buffer memory is reused as-is, without
+ * duplicating the file descriptors or invalidating CPU mappings.
+ *
+ * On kernels that back all dmabufs with a single shared inode, dmabuf objects
+ * are identified by their file descriptor numbers instead, and the planes of
+ * the buffer memory are always updated, as a file descriptor number may have
+ * been reused for a different dmabuf.
  *
  * If the Stream uses internally allocated memory, the index of the memory
  * buffer to use will match the one request at Stream::createBuffer(unsigned int)
@@ -547,6 +632,7 @@ std::unique_ptr<Buffer> Stream::createBuffer(const std::array<int, 3> &fds)
  * \return The buffer memory index for the buffer on success, or a negative
  * error code otherwise
  * \retval -ENOMEM No buffer memory was available to map the buffer
+ * \retval -EBADF The buffer contains an invalid dmabuf file descriptor
  */
 int Stream::mapBuffer(const Buffer *buffer)
 {
@@ -555,26 +641,67 @@ int Stream::mapBuffer(const Buffer *buffer)
 	if (bufferCache_.empty())
 		return -ENOMEM;
 
+	static const std::pair<dev_t, ino_t> anonInode = anonInodeIdentity();
+
 	const std::array<int, 3> &dmabufs = buffer->dmabufs();
+	DmabufIdentity identity{};
+	bool shared = false;
+
+	for (unsigned int i = 0; i < dmabufs.size(); ++i) {
+		if (dmabufs[i] == -1)
+			break;
+
+		struct stat st;
+		int ret = fstat(dmabufs[i], &st);
+		if (ret < 0) {
+			ret = -errno;
+			LOG(Stream, Error)
+				<< "Invalid dmabuf " << dmabufs[i] << ": "
+				<< strerror(-ret);
+			return ret;
+		}
+
+		identity[i] = { st.st_dev, st.st_ino };
+
+		/*
+		 * The shared anonymous inode lives on a different device than
+		 * the dmabuf inodes of newer kernels, the file descriptor
+		 * number can thus be stored in place of the inode number.
+		 */
+		if (identity[i] == anonInode) {
+			identity[i].second = dmabufs[i];
+			shared = true;
+		}
+	}
 
 	/*
-	 * Try to find a previously mapped buffer in the cache. If we miss, use
-	 * the oldest entry in the cache.
+	 * Try to find a previously mapped buffer in the cache. If we hit, the
+	 * buffer memory already references the same dmabuf objects and can be
+	 * used as-is, unless the dmabufs are identified by file descriptor
+	 * numbers. If we miss, use the oldest entry in the cache.
 	 */
 	auto map = std::find_if(bufferCache_.begin(), bufferCache_.end(),
-				[&](std::pair<std::array<int, 3>, unsigned int> &entry) {
-					return entry.first == dmabufs;
+				[&](unsigned int index) {
+					return bufferIdentities_[index] == identity;
 				});
+	if (map != bufferCache_.end() && !shared) {
+		unsigned int index = *map;
+		bufferCache_.erase(map);
+		return index;
+	}
+
 	if (map == bufferCache_.end())
 		map = bufferCache_.begin();
 
+	unsigned int index = *map;
+	bufferCache_.erase(map);
+
 	/*
-	 * Update the dmabuf file descriptors of the entry. We can't assume that
-	 * identical file descriptor numbers refer to the same dmabuf object as
-	 * it may have been closed and its file descriptor reused. We thus need
-	 * to update the plane's internally cached mmap()ed memory.
+	 * Update the dmabuf file descriptors of the planes. Any CPU mapping of
+	 * the previous dmabuf objects is released, and the planes are set up
+	 * according to the pool mapping policy. The size of the dmabuf is
+	 * retrieved with lseek() to allow mapping it.
 	 */
-	unsigned int index = map->second;
 	BufferMemory *mem = &bufferPool_.buffers()[index];
 	mem->planes().clear();
 
@@ -582,12 +709,18 @@ int Stream::mapBuffer(const Buffer *buffer)
 		if (dmabufs[i] == -1)
 			break;
 
+		off_t length = lseek(dmabufs[i], 0, SEEK_END);
+		if (length < 0)
+			length = 0;
+
 		mem->planes().emplace_back();
-		mem->planes().back().setDmabuf(dmabufs[i], 0);
+		Plane &plane = mem->planes().back();
+		plane.setMappingPolicy(bufferPool_.mappingPolicy());
+		plane.setDmabuf(dmabufs[i], length);
 	}
 
-	/* Remove the buffer from the cache and return its index. */
-	bufferCache_.erase(map);
+	bufferIdentities_[index] = identity;
+
 	return index;
 }
 
@@ -602,7 +735,7 @@ void Stream::unmapBuffer(const Buffer *buffer)
 {
 	ASSERT(memoryType_ == ExternalMemory);
 
-	bufferCache_.emplace_back(buffer->dmabufs(), buffer->index());
+	bufferCache_.push_back(buffer->index());
 }
 
 /**
@@ -611,14 +744,32 @@ void Stream::unmapBuffer(const Buffer *buffer)
  * \param[in] memory The stream memory type
  *
  * Create \a count empty buffers in the Stream's buffer pool.
+ *
+ * If the buffer pool is persistent and the stream keeps using internal memory,
+ * the existing buffers are kept and the pool is only resized to \a count
+ * buffers, to let the video device reuse their memory.
  */
 void Stream::createBuffers(MemoryType memory, unsigned int count)
 {
-	destroyBuffers();
+	/*
+	 * Reserve space for the buffers that may be added at runtime, as
+	 * queued buffers reference the pool's buffer memory by pointer.
+	 */
+	unsigned int capacity = std::max(count, configuration_.maxBufferCount);
+
+	if (bufferPool_.persistent() && memory == InternalMemory &&
+	    memoryType_ == InternalMemory && count) {
+		bufferPool_.buffers().reserve(capacity);
+		bufferPool_.createBuffers(count);
+		return;
+	}
+
+	bufferPool_.destroyBuffers();
 	if (count == 0)
 		return;
 
 	memoryType_ = memory;
+	bufferPool_.buffers().reserve(capacity);
 	bufferPool_.createBuffers(count);
 
 	/* Streams with internal memory usage do not need buffer mapping. */
@@ -627,24 +778,99 @@ void Stream::createBuffers(MemoryType memory, unsigned int count)
 
 	/*
 	 * Prepare for buffer mapping by adding all buffer memory entries to the
-	 * cache.
+	 * cache. Reserve space for the planes of all buffers to avoid
+	 * reallocating the planes vectors when buffers are mapped.
 	 */
+	bufferIdentities_.reserve(capacity);
+	bufferIdentities_.assign(bufferPool_.count(), DmabufIdentity{});
+
 	bufferCache_.clear();
-	for (unsigned int i = 0; i < bufferPool_.count(); ++i)
-		bufferCache_.emplace_back(std::array<int, 3>{ -1, -1, -1 }, i);
+	bufferCache_.reserve(capacity);
+	for (unsigned int i = 0; i < bufferPool_.count(); ++i) {
+		bufferPool_.buffers()[i].planes().reserve(3);
+		bufferCache_.push_back(i);
+	}
 }
 
 /**
  * \brief Destroy buffers in the stream
  *
  * If no buffers have been created or if buffers have already been destroyed no
- * operation is performed.
+ * operation is performed. The buffers of persistent pools with internal memory
+ * are kept.
  */
 void Stream::destroyBuffers()
 {
+	if (bufferPool_.persistent() && memoryType_ == InternalMemory)
+		return;
+
 	bufferPool_.destroyBuffers();
 }
 
+/**
+ * \brief Add buffers to the stream
+ * \param[in] count The number of buffers to add
+ *
+ * Grow the Stream's buffer pool by \a count empty buffers, up to the maximum
+ * number of buffers of the stream configuration. The memory of the new buffers
+ * shall then be allocated or imported by the pipeline handler. For streams
+ * using external memory, the new buffers are made available for buffer
+ * mapping.
+ *
+ * \return 0 on success or a negative error code otherwise
+ * \retval -ENOSPC The stream would exceed its maximum number of buffers
+ */
+int Stream::addBuffers(unsigned int count)
+{
+	unsigned int bufferCount = bufferPool_.count();
+
+	if (bufferCount + count > configuration_.maxBufferCount) {
+		LOG(Stream, Error)
+			<< "Can't grow stream beyond "
+			<< std::max(bufferCount, configuration_.maxBufferCount)
+			<< " buffers";
+		return -ENOSPC;
+	}
+
+	bufferPool_.createBuffers(bufferCount + count);
+
+	if (memoryType_ == InternalMemory)
+		return 0;
+
+	bufferIdentities_.resize(bufferPool_.count(), DmabufIdentity{});
+	for (unsigned int i = bufferCount; i < bufferPool_.count(); ++i) {
+		bufferPool_.buffers()[i].planes().reserve(3);
+		bufferCache_.push_back(i);
+	}
+
+	return 0;
+}
+
+/**
+ * \brief Remove buffers from the stream
+ * \param[in] count The number of buffers to remove
+ *
+ * Shrink the Stream's buffer pool by removing its last \a count buffers. This
+ * method is used to revert addBuffers() when the pipeline handler fails to
+ * allocate the new buffers, and the removed buffers shall not be in use.
+ */
+void Stream::removeBuffers(unsigned int count)
+{
+	unsigned int bufferCount = bufferPool_.count() - count;
+
+	bufferPool_.createBuffers(bufferCount);
+
+	if (memoryType_ == InternalMemory)
+		return;
+
+	bufferIdentities_.resize(bufferCount);
+	bufferCache_.erase(std::remove_if(bufferCache_.begin(), bufferCache_.end(),
+					  [bufferCount](unsigned int index) {
+						  return index >= bufferCount;
+					  }),
+			   bufferCache_.end());
+}
+
 /**
  * \var Stream::bufferPool_
  * \brief The pool of buffers associated with the stream
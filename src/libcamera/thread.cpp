@@ -8,13 +8,16 @@
 #include "thread.h"
 
 #include <atomic>
-#include <list>
+#include <string.h>
 
 #include <libcamera/event_dispatcher.h>
 
+#include "event_dispatcher_epoll.h"
 #include "event_dispatcher_poll.h"
 #include "log.h"
 #include "message.h"
+#include "trace.h"
+#include "utils.h"
 
 /**
  * \file thread.h
@@ -29,20 +32,130 @@ class ThreadMain;
 
 /**
  * \brief A queue of posted messages
+ *
+ * The message queue is a lock-free multi-producer single-consumer queue.
+ * Messages are linked through their Message::next_ pointer, so queuing a
+ * message doesn't allocate memory.
+ *
+ * Producers push messages to the \ref stack_ with an atomic compare and swap,
+ * without taking any lock. The consumer moves all messages from the stack to
+ * the FIFO \ref list_ in a single atomic exchange with collect(), restoring
+ * their posting order. All operations on the list are protected by the \ref
+ * mutex_, which producers never take.
  */
 class MessageQueue
 {
 public:
+	MessageQueue()
+		: stack_(nullptr), first_(nullptr), last_(nullptr)
+	{
+	}
+
+	~MessageQueue();
+
+	bool push(Message *msg);
+	void collect();
+	Message *pop();
+
+	/**
+	 * \brief Stack of messages posted and not collected yet
+	 */
+	std::atomic<Message *> stack_;
 	/**
-	 * \brief List of queued Message instances
+	 * \brief First message of the list of collected messages
 	 */
-	std::list<std::unique_ptr<Message>> list_;
+	Message *first_;
 	/**
-	 * \brief Protects the \ref list_
+	 * \brief Last message of the list of collected messages
+	 */
+	Message *last_;
+	/**
+	 * \brief Protects the list of collected messages
 	 */
 	Mutex mutex_;
 };
 
+MessageQueue::~MessageQueue()
+{
+	collect();
+
+	while (Message *msg = pop())
+		delete msg;
+}
+
+/**
+ * \brief Push a message to the queue
+ * \param[in] msg The message
+ *
+ * This method may be called from any thread without locking.
+ *
+ * \return True if the stack was empty before the message was pushed, false
+ * otherwise
+ */
+bool MessageQueue::push(Message *msg)
+{
+	Message *head = stack_.load(std::memory_order_relaxed);
+
+	do {
+		msg->next_ = head;
+	} while (!stack_.compare_exchange_weak(head, msg,
+					       std::memory_order_release,
+					       std::memory_order_relaxed));
+
+	return !head;
+}
+
+/**
+ * \brief Move all pushed messages to the list of collected messages
+ *
+ * The caller shall hold the \ref mutex_.
+ */
+void MessageQueue::collect()
+{
+	Message *msg = stack_.exchange(nullptr, std::memory_order_acquire);
+	if (!msg)
+		return;
+
+	/* Reverse the stack to restore the posting order. */
+	Message *first = nullptr;
+	Message *last = msg;
+
+	while (msg) {
+		Message *next = msg->next_;
+		msg->next_ = first;
+		first = msg;
+		msg = next;
+	}
+
+	if (last_)
+		last_->next_ = first;
+	else
+		first_ = first;
+
+	last_ = last;
+}
+
+/**
+ * \brief Remove the first message from the list of collected messages
+ *
+ * The caller shall hold the \ref mutex_.
+ *
+ * \return The message, or nullptr if the list is empty
+ */
+Message *MessageQueue::pop()
+{
+	Message *msg = first_;
+	if (!msg)
+		return nullptr;
+
+	first_ = msg->next_;
+	if (!first_)
+		last_ = nullptr;
+
+	msg->next_ = nullptr;
+	return msg;
+}
+
 /**
  * \brief Thread-local internal data
  */
@@ -334,12 +447,34 @@ void Thread::setEventDispatcher(std::unique_ptr<EventDispatcher> dispatcher)
 				 std::memory_order_relaxed);
 }
 
+/*
+ * Create the default event dispatcher. The implementation can be selected with
+ * the LIBCAMERA_EVENT_DISPATCHER environment variable, set to either "poll" or
+ * "epoll".
+ */
+static EventDispatcher *createEventDispatcher()
+{
+	const char *type = utils::secure_getenv("LIBCAMERA_EVENT_DISPATCHER");
+	if (!type || !strcmp(type, "poll"))
+		return new EventDispatcherPoll();
+
+	if (!strcmp(type, "epoll"))
+		return new EventDispatcherEpoll();
+
+	LOG(Thread, Warning)
+		<< "Unknown event dispatcher " << type << ", using poll";
+
+	return new EventDispatcherPoll();
+}
+
 /**
  * \brief Retrieve the event dispatcher
  *
  * This method retrieves the event dispatcher set with setEventDispatcher().
- * If no dispatcher has been set, a default poll-based implementation is created
- * and returned, and no custom event dispatcher may be installed anymore.
+ * If no dispatcher has been set, a default implementation is created and
+ * returned, and no custom event dispatcher may be installed anymore. The
+ * default implementation is poll-based, unless the LIBCAMERA_EVENT_DISPATCHER
+ * environment variable is set to "epoll".
  *
  * The returned event dispatcher is valid until the thread is destroyed.
  *
@@ -348,7 +483,7 @@ void Thread::setEventDispatcher(std::unique_ptr<EventDispatcher> dispatcher)
 EventDispatcher *Thread::eventDispatcher()
 {
 	if (!data_->dispatcher_.load(std::memory_order_relaxed))
-		data_->dispatcher_.store(new EventDispatcherPoll(),
+		data_->dispatcher_.store(createEventDispatcher(),
 					 std::memory_order_release);
 
 	return data_->dispatcher_.load(std::memory_order_relaxed);
@@ -363,6 +498,11 @@ EventDispatcher *Thread::eventDispatcher()
  * the \a receiver and wake up the thread's event loop. Message ownership is
  * passed to the thread, and the message will be deleted after being delivered.
  *
+ * Posting a message doesn't take any lock. The thread's event loop is only
+ * woken up when the message queue transitions from empty to non-empty, as
+ * messages posted to a non-empty queue will be delivered along with the
+ * messages already queued.
+ *
  * Messages are delivered through the thread's event loop. If the thread is not
  * running its event loop the message will not be delivered until the event
  * loop gets started.
@@ -377,10 +517,9 @@ void Thread::postMessage(std::unique_ptr<Message> msg, Object *receiver)
 
 	ASSERT(data_ == receiver->thread()->data_);
 
-	MutexLocker locker(data_->messages_.mutex_);
-	data_->messages_.list_.push_back(std::move(msg));
 	receiver->pendingMessages_++;
-	locker.unlock();
+	if (!data_->messages_.push(msg.release()))
+		return;
 
 	EventDispatcher *dispatcher =
 		data_->dispatcher_.load(std::memory_order_acquire);
@@ -398,31 +537,53 @@ void Thread::removeMessages(Object *receiver)
 {
 	ASSERT(data_ == receiver->thread()->data_);
 
-	MutexLocker locker(data_->messages_.mutex_);
+	MessageQueue &queue = data_->messages_;
+
+	MutexLocker locker(queue.mutex_);
 	if (!receiver->pendingMessages_)
 		return;
 
-	std::vector<std::unique_ptr<Message>> toDelete;
-	for (std::unique_ptr<Message> &msg : data_->messages_.list_) {
-		if (!msg)
-			continue;
-		if (msg->receiver_ != receiver)
+	queue.collect();
+
+	/*
+	 * Move the messages to a pending deletion list to delete them after
+	 * releasing the lock.
+	 */
+	Message *toDelete = nullptr;
+	Message *prev = nullptr;
+	Message *msg = queue.first_;
+
+	while (msg) {
+		Message *next = msg->next_;
+
+		if (msg->receiver_ != receiver) {
+			prev = msg;
+			msg = next;
 			continue;
+		}
 
-		/*
-		 * Move the message to the pending deletion list to delete it
-		 * after releasing the lock. The messages list element will
-		 * contain a null pointer, and will be removed when dispatching
-		 * messages.
-		 */
-		toDelete.push_back(std::move(msg));
+		if (prev)
+			prev->next_ = next;
+		else
+			queue.first_ = next;
+		if (queue.last_ == msg)
+			queue.last_ = prev;
+
+		msg->next_ = toDelete;
+		toDelete = msg;
 		receiver->pendingMessages_--;
+
+		msg = next;
 	}
 
 	ASSERT(!receiver->pendingMessages_);
 	locker.unlock();
 
-	toDelete.clear();
+	while (toDelete) {
+		Message *next = toDelete->next_;
+		delete toDelete;
+		toDelete = next;
+	}
 }
 
 /**
@@ -430,22 +591,33 @@ void Thread::removeMessages(Object *receiver)
  */
 void Thread::dispatchMessages()
 {
-	MutexLocker locker(data_->messages_.mutex_);
+	TRACE_SCOPE(Thread, "Thread::dispatchMessages");
+
+	MessageQueue &queue = data_->messages_;
+
+	MutexLocker locker(queue.mutex_);
 
-	while (!data_->messages_.list_.empty()) {
-		std::unique_ptr<Message> msg = std::move(data_->messages_.list_.front());
-		data_->messages_.list_.pop_front();
+	while (true) {
+		if (!queue.first_)
+			queue.collect();
+
+		std::unique_ptr<Message> msg(queue.pop());
 		if (!msg)
-			continue;
+			break;
 
 		Object *receiver = msg->receiver_;
 		ASSERT(data_ == receiver->thread()->data_);
 
+		/*
+		 * Account for the message before delivering it, as the
+		 * receiver may be deleted by its message handler.
+		 */
+		receiver->pendingMessages_--;
+
 		locker.unlock();
 		receiver->message(msg.get());
+		msg.reset();
 		locker.lock();
-
-		receiver->pendingMessages_--;
 	}
 }
 
@@ -464,14 +636,40 @@ void Thread::moveObject(Object *object)
 
 	/* Move pending messages to the message queue of the new thread. */
 	if (object->pendingMessages_) {
-		for (std::unique_ptr<Message> &msg : currentData->messages_.list_) {
-			if (!msg)
-				continue;
-			if (msg->receiver_ != object)
+		MessageQueue &queue = currentData->messages_;
+		MutexLocker locker(queue.mutex_);
+		bool wakeup = false;
+
+		queue.collect();
+
+		Message *prev = nullptr;
+		Message *msg = queue.first_;
+
+		while (msg) {
+			Message *next = msg->next_;
+
+			if (msg->receiver_ != object) {
+				prev = msg;
+				msg = next;
 				continue;
+			}
+
+			if (prev)
+				prev->next_ = next;
+			else
+				queue.first_ = next;
+			if (queue.last_ == msg)
+				queue.last_ = prev;
 
-			targetData->messages_.list_.push_back(std::move(msg));
+			wakeup |= targetData->messages_.push(msg);
+
+			msg = next;
 		}
+
+		EventDispatcher *dispatcher =
+			targetData->dispatcher_.load(std::memory_order_acquire);
+		if (wakeup && dispatcher)
+			dispatcher->interrupt();
 	}
 
 	object->thread_ = this;
@@ -39,7 +39,7 @@ LOG_DEFINE_CATEGORY(Timer)
  * \brief Construct a timer
  */
 Timer::Timer()
-	: interval_(0), deadline_(0)
+	: interval_(0), deadline_(0), queueIndex_(NotQueued)
 {
 }
 
@@ -0,0 +1,243 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * timer_queue.cpp - Deadline-ordered timer queue
+ */
+
+#include "timer_queue.h"
+
+#include <errno.h>
+#include <string.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <libcamera/timer.h>
+
+#include "log.h"
+
+/**
+ * \file timer_queue.h
+ * \brief Deadline-ordered timer queue
+ */
+
+namespace libcamera {
+
+LOG_DECLARE_CATEGORY(Event)
+
+/**
+ * \class TimerQueue
+ * \brief A queue of running timers for use by event dispatchers
+ *
+ * The TimerQueue stores running timers in a binary min-heap ordered by
+ * deadline, giving O(log n) insertion and removal. Each timer records its
+ * position in the heap, so removal doesn't require searching for the timer.
+ *
+ * The queue is backed by a timerfd that is armed for the earliest deadline.
+ * Event dispatchers monitor the file descriptor returned by fd() for
+ * readability alongside their other file descriptors, and call process() when
+ * it becomes readable. This removes the need to compute a timeout, and thus to
+ * read the clock, at every iteration of the event loop.
+ */
+
+/**
+ * \brief Construct an empty timer queue
+ *
+ * Failure to create the timerfd is fatal, as timers can't be implemented
+ * without it.
+ */
+TimerQueue::TimerQueue()
+	: armed_(0), processing_(false)
+{
+	fd_ = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+	if (fd_ < 0)
+		LOG(Event, Fatal) << "Unable to create timerfd";
+}
+
+TimerQueue::~TimerQueue()
+{
+	for (Timer *timer : timers_)
+		timer->queueIndex_ = Timer::NotQueued;
+
+	close(fd_);
+}
+
+/**
+ * \fn TimerQueue::fd()
+ * \brief Retrieve the file descriptor signalling timer expiration
+ * \return The timerfd file descriptor
+ */
+
+/**
+ * \brief Add a \a timer to the queue
+ * \param[in] timer The timer
+ *
+ * If the \a timer is already queued, its position in the queue is updated to
+ * match its current deadline.
+ */
+void TimerQueue::add(Timer *timer)
+{
+	if (queued(timer)) {
+		siftUp(timer->queueIndex_);
+		siftDown(timer->queueIndex_);
+	} else {
+		timers_.push_back(timer);
+		place(timer, timers_.size() - 1);
+		siftUp(timer->queueIndex_);
+	}
+
+	arm();
+}
+
+/**
+ * \brief Remove a \a timer from the queue
+ * \param[in] timer The timer
+ *
+ * If the \a timer isn't queued this method performs no operation.
+ */
+void TimerQueue::remove(Timer *timer)
+{
+	if (!queued(timer))
+		return;
+
+	unsigned int index = timer->queueIndex_;
+	Timer *last = timers_.back();
+	timers_.pop_back();
+	timer->queueIndex_ = Timer::NotQueued;
+
+	if (last != timer) {
+		place(last, index);
+		siftUp(index);
+		siftDown(last->queueIndex_);
+	}
+
+	arm();
+}
+
+/**
+ * \brief Process expired timers
+ *
+ * This method shall be called by the event dispatcher when the timer queue
+ * file descriptor becomes readable. It removes all expired timers from the
+ * queue and emits their timeout signal, in deadline order.
+ */
+void TimerQueue::process()
+{
+	uint64_t expirations;
+	ssize_t ret = read(fd_, &expirations, sizeof(expirations));
+	if (ret < 0 && errno != EAGAIN) {
+		ret = -errno;
+		LOG(Event, Error)
+			<< "Failed to read timerfd: " << strerror(-ret);
+	}
+
+	/* The timerfd is disarmed once it expires. */
+	armed_ = 0;
+
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	uint64_t now = ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+
+	/*
+	 * Timeout handlers may start or stop timers, defer rearming the timerfd
+	 * until all expired timers have been processed.
+	 */
+	processing_ = true;
+
+	while (!timers_.empty()) {
+		Timer *timer = timers_.front();
+		if (timer->deadline() > now)
+			break;
+
+		remove(timer);
+		timer->stop();
+		timer->timeout.emit(timer);
+	}
+
+	processing_ = false;
+
+	arm();
+}
+
+bool TimerQueue::queued(Timer *timer) const
+{
+	unsigned int index = timer->queueIndex_;
+	return index < timers_.size() && timers_[index] == timer;
+}
+
+void TimerQueue::place(Timer *timer, unsigned int index)
+{
+	timers_[index] = timer;
+	timer->queueIndex_ = index;
+}
+
+void TimerQueue::siftUp(unsigned int index)
+{
+	Timer *timer = timers_[index];
+
+	while (index > 0) {
+		unsigned int parent = (index - 1) / 2;
+		if (timers_[parent]->deadline() <= timer->deadline())
+			break;
+
+		place(timers_[parent], index);
+		index = parent;
+	}
+
+	place(timer, index);
+}
+
+void TimerQueue::siftDown(unsigned int index)
+{
+	Timer *timer = timers_[index];
+	unsigned int size = timers_.size();
+
+	while (true) {
+		unsigned int child = index * 2 + 1;
+		if (child >= size)
+			break;
+
+		if (child + 1 < size &&
+		    timers_[child + 1]->deadline() < timers_[child]->deadline())
+			child++;
+
+		if (timer->deadline() <= timers_[child]->deadline())
+			break;
+
+		place(timers_[child], index);
+		index = child;
+	}
+
+	place(timer, index);
+}
+
+/*
+ * Arm the timerfd for the earliest deadline, or disarm it if the queue is
+ * empty. The timerfd is only reprogrammed when the earliest deadline changes.
+ */
+void TimerQueue::arm()
+{
+	if (processing_)
+		return;
+
+	uint64_t deadline = timers_.empty() ? 0 : timers_.front()->deadline();
+	if (deadline == armed_)
+		return;
+
+	struct itimerspec its = {};
+	its.it_value.tv_sec = deadline / 1000000000ULL;
+	its.it_value.tv_nsec = deadline % 1000000000ULL;
+
+	int ret = timerfd_settime(fd_, TFD_TIMER_ABSTIME, &its, nullptr);
+	if (ret < 0) {
+		ret = -errno;
+		LOG(Event, Error)
+			<< "Failed to arm timerfd: " << strerror(-ret);
+		return;
+	}
+
+	armed_ = deadline;
+}
+
+} /* namespace libcamera */
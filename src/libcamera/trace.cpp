@@ -0,0 +1,223 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * trace.cpp - Trace event recording
+ */
+
+#include "trace.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "utils.h"
+
+/**
+ * \file trace.h
+ * \brief Trace event recording
+ *
+ * libcamera can record the duration of operations on its hot path, such as
+ * event processing, message dispatching, V4L2 ioctls, IPC transfers and
+ * pipeline handler buffer completion slots, to visualize thread interleaving
+ * and per-frame critical paths offline.
+ *
+ * Tracing is disabled by default. It is enabled by setting the
+ * LIBCAMERA_TRACE_FILE environment variable to the name of a file, which is
+ * then truncated and filled with events in the Chrome JSON trace event format.
+ * The file can be loaded in chrome://tracing or in the Perfetto UI. If any
+ * error occurs when opening the file, tracing stays disabled.
+ *
+ * Trace events are recorded with the TRACE_SCOPE() macro, which records a
+ * complete event covering the lifetime of the enclosing scope. When tracing is
+ * disabled the cost of a trace scope is limited to a check of a boolean flag,
+ * inlined in the caller.
+ *
+ * Events are flushed to the trace file periodically, and the file is completed
+ * when the library is unloaded or when Tracer::stop() is called.
+ */
+
+namespace libcamera {
+
+namespace {
+
+pid_t currentThreadId()
+{
+	static thread_local pid_t tid = syscall(SYS_gettid);
+	return tid;
+}
+
+} /* namespace */
+
+/**
+ * \class Tracer
+ * \brief Trace event writer
+ *
+ * The Tracer class handles the trace configuration and writes trace events to
+ * the trace file. It is a singleton, and is safe to use from any thread.
+ */
+
+/*
+ * The tracer is created when the library is loaded, to enable tracing before
+ * any trace scope checks the enabled flag.
+ */
+std::atomic<bool> Tracer::enabled_(Tracer::instance()->parseTraceFile());
+
+/**
+ * \brief Retrieve the tracer instance
+ *
+ * The Tracer is a singleton and can't be constructed manually. This function
+ * shall instead be used to retrieve the single global instance of the tracer.
+ *
+ * \return The tracer instance
+ */
+Tracer *Tracer::instance()
+{
+	static Tracer instance;
+	return &instance;
+}
+
+/**
+ * \fn Tracer::enabled()
+ * \brief Check if tracing is enabled
+ *
+ * This function doesn't access the tracer instance, and is cheap enough to be
+ * called on hot paths.
+ *
+ * \return True if trace events are recorded, false otherwise
+ */
+
+/**
+ * \brief Write a complete trace event to the trace file
+ * \param[in] category The event category
+ * \param[in] name The event name
+ * \param[in] start The event start time, from utils::clock_monotonic()
+ * \param[in] end The event end time, from utils::clock_monotonic()
+ *
+ * The event is attributed to the calling thread. The \a category and \a name
+ * strings are written verbatim and shall not contain characters that require
+ * escaping in JSON strings.
+ */
+void Tracer::write(const char *category, const char *name,
+		   uint64_t start, uint64_t end)
+{
+	pid_t tid = currentThreadId();
+	uint64_t duration = end - start;
+
+	std::lock_guard<std::mutex> locker(mutex_);
+
+	/* Tracing may have been stopped since the scope started. */
+	if (!enabled())
+		return;
+
+	/* Timestamps are expressed in microseconds with nanosecond precision. */
+	char event[256];
+	snprintf(event, sizeof(event),
+		 "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\","
+		 "\"ts\":%" PRIu64 ".%03" PRIu64 ",\"dur\":%" PRIu64 ".%03" PRIu64 ","
+		 "\"pid\":%d,\"tid\":%d}",
+		 empty_ ? "" : ",\n", name, category,
+		 start / 1000, start % 1000, duration / 1000, duration % 1000,
+		 pid_, tid);
+
+	file_ << event;
+	empty_ = false;
+
+	/* Flush periodically to make events available to live tools. */
+	if (end - lastFlush_ >= FlushInterval) {
+		file_.flush();
+		lastFlush_ = end;
+	}
+}
+
+/**
+ * \brief Stop tracing and complete the trace file
+ *
+ * Trace events recorded after this function returns are discarded. The trace
+ * file is completed and closed, and can then be loaded by trace viewers.
+ */
+void Tracer::stop()
+{
+	std::lock_guard<std::mutex> locker(mutex_);
+
+	if (!enabled())
+		return;
+
+	enabled_.store(false, std::memory_order_relaxed);
+
+	file_ << "\n]\n";
+	file_.close();
+}
+
+/**
+ * \brief Construct a tracer
+ */
+Tracer::Tracer()
+	: empty_(true), lastFlush_(0), pid_(getpid())
+{
+}
+
+Tracer::~Tracer()
+{
+	stop();
+}
+
+/**
+ * \brief Parse the trace output file from the environment
+ *
+ * If the LIBCAMERA_TRACE_FILE environment variable is set, open the file it
+ * points to. Errors are silently ignored and leave tracing disabled.
+ *
+ * \return True if tracing shall be enabled, false otherwise
+ */
+bool Tracer::parseTraceFile()
+{
+	const char *file = utils::secure_getenv("LIBCAMERA_TRACE_FILE");
+	if (!file)
+		return false;
+
+	file_.open(file);
+	if (!file_.good())
+		return false;
+
+	file_ << "[\n";
+	return true;
+}
+
+/**
+ * \class TraceScope
+ * \brief Record a trace event covering a scope
+ *
+ * The TraceScope class records the time at which it is constructed, and writes
+ * a complete trace event spanning from construction to destruction. It should
+ * not be used directly, the TRACE_SCOPE() macro should be used instead.
+ */
+
+/**
+ * \fn TraceScope::TraceScope()
+ * \brief Construct a trace scope
+ * \param[in] category The event category
+ * \param[in] name The event name
+ *
+ * The \a category and \a name strings are not copied and shall remain valid
+ * for the whole lifetime of the trace scope.
+ */
+
+/**
+ * \fn TraceScope::~TraceScope()
+ * \brief Destroy the trace scope and record its trace event
+ */
+
+/**
+ * \def TRACE_SCOPE(category, name)
+ * \brief Record a trace event covering the enclosing scope
+ * \param[in] category The event category, as a bare identifier
+ * \param[in] name The event name string
+ *
+ * This macro records a complete trace event from the point where it is used to
+ * the end of the enclosing scope. Only one trace scope can be declared in a
+ * given scope.
+ */
+
+} /* namespace libcamera */
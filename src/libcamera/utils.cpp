@@ -9,6 +9,7 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
 
 /**
@@ -68,6 +69,18 @@ char *secure_getenv(const char *name)
 #endif
 }
 
+/**
+ * \brief Retrieve the current time of the monotonic clock
+ * \return The current time of CLOCK_MONOTONIC in nanoseconds
+ */
+uint64_t clock_monotonic()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
 /**
  * \fn libcamera::utils::make_unique(Args &&... args)
  * \brief Constructs an object of type T and wraps it in a std::unique_ptr.
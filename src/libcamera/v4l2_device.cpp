@@ -13,6 +13,7 @@
 #include <unistd.h>
 
 #include "log.h"
+#include "trace.h"
 #include "v4l2_controls.h"
 
 /**
@@ -286,6 +287,8 @@ int V4L2Device::setControls(V4L2ControlList *ctrls)
  */
 int V4L2Device::ioctl(unsigned long request, void *argp)
 {
+	TRACE_SCOPE(V4L2, "V4L2Device::ioctl");
+
 	/*
 	 * Printing out an error message is usually better performed
 	 * in the caller, which can provide more context.
@@ -7,6 +7,7 @@
 
 #include "v4l2_videodevice.h"
 
+#include <algorithm>
 #include <fcntl.h>
 #include <iomanip>
 #include <sstream>
@@ -19,10 +20,13 @@
 
 #include <libcamera/buffer.h>
 #include <libcamera/event_notifier.h>
+#include <libcamera/stream.h>
 
 #include "log.h"
 #include "media_device.h"
 #include "media_object.h"
+#include "trace.h"
+#include "utils.h"
 
 /**
  * \file v4l2_videodevice.h
@@ -716,6 +720,13 @@ int V4L2VideoDevice::requestBuffers(unsigned int count)
 	struct v4l2_requestbuffers rb = {};
 	int ret;
 
+	if (count > VIDEO_MAX_FRAME) {
+		LOG(V4L2, Error)
+			<< "Unable to request " << count << " buffers: "
+			<< "maximum is " << VIDEO_MAX_FRAME;
+		return -EINVAL;
+	}
+
 	rb.count = count;
 	rb.type = bufferType_;
 	rb.memory = memoryType_;
@@ -733,18 +744,40 @@ int V4L2VideoDevice::requestBuffers(unsigned int count)
 	return rb.count;
 }
 
+/*
+ * Size the queued buffers table to match the buffer pool. This and
+ * addBuffers() are the only places where the table is allocated, to keep the
+ * queueBuffer() and dequeueBuffer() paths free of memory allocations.
+ */
+void V4L2VideoDevice::setBufferPool(BufferPool *pool)
+{
+	bufferPool_ = pool;
+
+	queuedBuffers_.assign(pool ? pool->count() : 0, nullptr);
+	queuedMask_.reset();
+}
+
 /**
  * \brief Request buffers to be allocated from the video device and stored in
  * the buffer pool provided.
  * \param[out] pool BufferPool to populate with buffers
+ *
+ * If the \a pool is persistent, its buffers are reused when they are large
+ * enough for the current format of the video device, and are otherwise
+ * reallocated with planes large enough for both the current format and the
+ * previous buffers. Persistent buffers are used by the video device with the
+ * V4L2_MEMORY_DMABUF memory type.
+ *
  * \return 0 on success or a negative error code otherwise
  */
 int V4L2VideoDevice::exportBuffers(BufferPool *pool)
 {
 	unsigned int allocatedBuffers;
-	unsigned int i;
 	int ret;
 
+	if (pool->persistent())
+		return exportPersistentBuffers(pool);
+
 	memoryType_ = V4L2_MEMORY_MMAP;
 
 	ret = requestBuffers(pool->count());
@@ -759,8 +792,160 @@ int V4L2VideoDevice::exportBuffers(BufferPool *pool)
 		return -ENOMEM;
 	}
 
-	/* Map the buffers. */
-	for (i = 0; i < pool->count(); ++i) {
+	ret = exportPlanes(pool, 0);
+	if (ret) {
+		requestBuffers(0);
+		pool->destroyBuffers();
+		return ret;
+	}
+
+	setBufferPool(pool);
+
+	return 0;
+}
+
+/*
+ * V4L2 doesn't allow changing the format of a video device while buffers are
+ * allocated in its queue. Persistent buffers are thus allocated with
+ * VIDIOC_CREATE_BUFS, exported to the pool as dmabufs, and immediately released
+ * from the queue. The pool holds the only references to the buffers memory,
+ * which is then imported in the video device. Reconfiguring the device only
+ * requires a cheap VIDIOC_REQBUFS for dmabufs, unless the new format needs
+ * larger buffers.
+ */
+int V4L2VideoDevice::exportPersistentBuffers(BufferPool *pool)
+{
+	V4L2DeviceFormat format = {};
+	int ret;
+
+	ret = getFormat(&format);
+	if (ret)
+		return ret;
+
+	if (isPoolCompatible(pool, format)) {
+		LOG(V4L2, Debug)
+			<< "Reusing " << pool->count() << " persistent buffers";
+	} else {
+		ret = createPersistentBuffers(pool, format);
+		if (ret)
+			return ret;
+	}
+
+	return importBuffers(pool);
+}
+
+int V4L2VideoDevice::createPersistentBuffers(BufferPool *pool,
+					     const V4L2DeviceFormat &format)
+{
+	struct v4l2_create_buffers create = {};
+	unsigned int sizes[3];
+	int ret;
+
+	/* Size the buffers for the largest of the format and existing planes. */
+	for (unsigned int p = 0; p < format.planesCount; ++p) {
+		sizes[p] = format.planes[p].size;
+
+		for (BufferMemory &buffer : pool->buffers()) {
+			if (buffer.planes().size() != format.planesCount)
+				continue;
+
+			sizes[p] = std::max(sizes[p], buffer.planes()[p].length());
+		}
+	}
+
+	/* Release all buffers from the queue, regardless of their memory type. */
+	memoryType_ = V4L2_MEMORY_MMAP;
+
+	ret = requestBuffers(0);
+	if (ret < 0)
+		return ret;
+
+	create.count = pool->count();
+	create.memory = memoryType_;
+	create.format.type = bufferType_;
+
+	ret = ioctl(VIDIOC_G_FMT, &create.format);
+	if (ret < 0) {
+		LOG(V4L2, Error) << "Unable to get format: " << strerror(-ret);
+		return ret;
+	}
+
+	if (V4L2_TYPE_IS_MULTIPLANAR(bufferType_)) {
+		for (unsigned int p = 0; p < format.planesCount; ++p)
+			create.format.fmt.pix_mp.plane_fmt[p].sizeimage = sizes[p];
+	} else if (caps_.isMeta()) {
+		create.format.fmt.meta.buffersize = sizes[0];
+	} else {
+		create.format.fmt.pix.sizeimage = sizes[0];
+	}
+
+	ret = ioctl(VIDIOC_CREATE_BUFS, &create);
+	if (ret < 0) {
+		LOG(V4L2, Error)
+			<< "Unable to create " << pool->count() << " buffers: "
+			<< strerror(-ret);
+		return ret;
+	}
+
+	if (create.count < pool->count()) {
+		LOG(V4L2, Error)
+			<< "Not enough buffers provided by V4L2VideoDevice";
+		requestBuffers(0);
+		return -ENOMEM;
+	}
+
+	LOG(V4L2, Debug)
+		<< create.count << " persistent buffers created, plane 0 size "
+		<< sizes[0];
+
+	/* Drop the previous buffers and export the new ones to the pool. */
+	for (BufferMemory &buffer : pool->buffers())
+		buffer.planes().clear();
+
+	ret = exportPlanes(pool, 0);
+
+	/* The exported dmabufs keep the memory alive after release. */
+	requestBuffers(0);
+
+	if (ret) {
+		pool->destroyBuffers();
+		return ret;
+	}
+
+	return 0;
+}
+
+/*
+ * A persistent pool can be reused if all its buffers have the number of planes
+ * of the format, each large enough to store the corresponding format plane.
+ */
+bool V4L2VideoDevice::isPoolCompatible(BufferPool *pool,
+				       const V4L2DeviceFormat &format)
+{
+	for (BufferMemory &buffer : pool->buffers()) {
+		const std::vector<Plane> &planes = buffer.planes();
+
+		if (planes.size() != format.planesCount)
+			return false;
+
+		for (unsigned int p = 0; p < format.planesCount; ++p) {
+			if (planes[p].length() < format.planes[p].size)
+				return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+ * Query the buffers allocated in the video device queue, starting at index
+ * \a first, and export their planes to the buffer pool.
+ */
+int V4L2VideoDevice::exportPlanes(BufferPool *pool, unsigned int first)
+{
+	int ret = 0;
+
+	for (unsigned int i = first; i < pool->count(); ++i) {
 		struct v4l2_plane planes[VIDEO_MAX_PLANES] = {};
 		struct v4l2_buffer buf = {};
 		BufferMemory &buffer = pool->buffers()[i];
@@ -776,7 +961,7 @@ int V4L2VideoDevice::exportBuffers(BufferPool *pool)
 			LOG(V4L2, Error)
 				<< "Unable to query buffer " << i << ": "
 				<< strerror(-ret);
-			break;
+			return ret;
 		}
 
 		if (V4L2_TYPE_IS_MULTIPLANAR(buf.type)) {
@@ -792,17 +977,12 @@ int V4L2VideoDevice::exportBuffers(BufferPool *pool)
 
 		if (ret) {
 			LOG(V4L2, Error) << "Failed to create plane";
-			break;
+			return ret;
 		}
 	}
 
-	if (ret) {
-		requestBuffers(0);
-		pool->destroyBuffers();
-		return ret;
-	}
-
-	bufferPool_ = pool;
+	/* Apply the pool mapping policy to the newly created planes. */
+	pool->setMappingPolicy(pool->mappingPolicy());
 
 	return 0;
 }
@@ -863,7 +1043,99 @@ int V4L2VideoDevice::importBuffers(BufferPool *pool)
 	}
 
 	LOG(V4L2, Debug) << "provided pool of " << pool->count() << " buffers";
-	bufferPool_ = pool;
+	setBufferPool(pool);
+
+	return 0;
+}
+
+/**
+ * \brief Add buffers to the video device
+ * \param[in] count The number of buffers to add
+ *
+ * Allocate \a count buffers with VIDIOC_CREATE_BUFS in addition to the buffers
+ * allocated by exportBuffers() or importBuffers(), sized for the current
+ * format. This method may be called while the video device is streaming.
+ *
+ * The buffer pool associated with the video device shall have been grown by \a
+ * count buffers before calling this method. For exported buffers, the memory of
+ * the new buffers is exported to the last \a count buffers of the pool. For
+ * imported buffers, the new buffers are ready to be queued with the dmabufs of
+ * the pool.
+ *
+ * V4L2 doesn't support freeing individual buffers, the added buffers are
+ * released with all other buffers by releaseBuffers(). Buffers can't be added
+ * to persistent pools.
+ *
+ * \return 0 on success or a negative error code otherwise
+ */
+int V4L2VideoDevice::addBuffers(unsigned int count)
+{
+	struct v4l2_create_buffers create = {};
+	unsigned int index = queuedBuffers_.size();
+	int ret;
+
+	if (!bufferPool_ || index + count > bufferPool_->count()) {
+		LOG(V4L2, Error)
+			<< "Buffer pool too small to add " << count << " buffers";
+		return -EINVAL;
+	}
+
+	if (bufferPool_->persistent()) {
+		LOG(V4L2, Error) << "Can't add buffers to a persistent pool";
+		return -ENOTSUP;
+	}
+
+	if (index + count > VIDEO_MAX_FRAME) {
+		LOG(V4L2, Error)
+			<< "Unable to add " << count << " buffers: "
+			<< "maximum is " << VIDEO_MAX_FRAME;
+		return -EINVAL;
+	}
+
+	create.count = count;
+	create.memory = memoryType_;
+	create.format.type = bufferType_;
+
+	ret = ioctl(VIDIOC_G_FMT, &create.format);
+	if (ret < 0) {
+		LOG(V4L2, Error) << "Unable to get format: " << strerror(-ret);
+		return ret;
+	}
+
+	ret = ioctl(VIDIOC_CREATE_BUFS, &create);
+	if (ret < 0) {
+		LOG(V4L2, Error)
+			<< "Unable to add " << count << " buffers: "
+			<< strerror(-ret);
+		return ret;
+	}
+
+	/*
+	 * The buffers created by a failed addition can't be freed, and will
+	 * make all further additions fail until the buffers are released.
+	 */
+	if (create.index != index || create.count < count) {
+		LOG(V4L2, Error)
+			<< "Unable to add " << count << " buffers: "
+			<< create.count << " buffers created at index "
+			<< create.index;
+		return -ENOMEM;
+	}
+
+	if (memoryType_ == V4L2_MEMORY_MMAP) {
+		ret = exportPlanes(bufferPool_, index);
+		if (ret) {
+			for (unsigned int i = index; i < bufferPool_->count(); ++i)
+				bufferPool_->buffers()[i].planes().clear();
+			return ret;
+		}
+	}
+
+	queuedBuffers_.resize(index + count, nullptr);
+
+	LOG(V4L2, Debug)
+		<< count << " buffers added, " << queuedBuffers_.size()
+		<< " buffers available";
 
 	return 0;
 }
@@ -875,7 +1147,7 @@ int V4L2VideoDevice::releaseBuffers()
 {
 	LOG(V4L2, Debug) << "Releasing bufferPool";
 
-	bufferPool_ = nullptr;
+	setBufferPool(nullptr);
 
 	return requestBuffers(0);
 }
@@ -898,6 +1170,11 @@ int V4L2VideoDevice::queueBuffer(Buffer *buffer)
 	int ret;
 
 	buf.index = buffer->index();
+	if (buf.index >= queuedBuffers_.size()) {
+		LOG(V4L2, Error) << "Invalid buffer index " << buf.index;
+		return -EINVAL;
+	}
+
 	buf.type = bufferType_;
 	buf.memory = memoryType_;
 	buf.field = V4L2_FIELD_NONE;
@@ -937,10 +1214,16 @@ int V4L2VideoDevice::queueBuffer(Buffer *buffer)
 		return ret;
 	}
 
-	if (queuedBuffers_.empty())
+	if (buffer->traced_)
+		buffer->traceQueued_ = utils::clock_monotonic();
+
+	if (queuedMask_.none()) {
 		fdEvent_->setEnabled(true);
+		stats_.stopUnderrun();
+	}
 
 	queuedBuffers_[buf.index] = buffer;
+	queuedMask_.set(buf.index);
 
 	return 0;
 }
@@ -972,7 +1255,7 @@ std::vector<std::unique_ptr<Buffer>> V4L2VideoDevice::queueAllBuffers()
 {
 	int ret;
 
-	if (!queuedBuffers_.empty())
+	if (queuedMask_.any())
 		return {};
 
 	if (V4L2_TYPE_IS_OUTPUT(bufferType_))
@@ -1015,19 +1298,26 @@ Buffer *V4L2VideoDevice::dequeueBuffer()
 
 	ret = ioctl(VIDIOC_DQBUF, &buf);
 	if (ret < 0) {
-		LOG(V4L2, Error)
-			<< "Failed to dequeue buffer: " << strerror(-ret);
+		if (ret != -EAGAIN)
+			LOG(V4L2, Error)
+				<< "Failed to dequeue buffer: " << strerror(-ret);
 		return nullptr;
 	}
 
-	ASSERT(buf.index < bufferPool_->count());
+	ASSERT(buf.index < queuedBuffers_.size());
+	ASSERT(queuedMask_.test(buf.index));
+
+	Buffer *buffer = queuedBuffers_[buf.index];
+	queuedBuffers_[buf.index] = nullptr;
+	queuedMask_.reset(buf.index);
 
-	auto it = queuedBuffers_.find(buf.index);
-	Buffer *buffer = it->second;
-	queuedBuffers_.erase(it);
+	if (buffer->traced_)
+		buffer->traceDequeued_ = utils::clock_monotonic();
 
-	if (queuedBuffers_.empty())
+	if (queuedMask_.none()) {
 		fdEvent_->setEnabled(false);
+		stats_.startUnderrun();
+	}
 
 	buffer->index_ = buf.index;
 	buffer->bytesused_ = buf.bytesused;
@@ -1037,6 +1327,10 @@ Buffer *V4L2VideoDevice::dequeueBuffer()
 	buffer->status_ = buf.flags & V4L2_BUF_FLAG_ERROR
 			? Buffer::BufferError : Buffer::BufferSuccess;
 
+	stats_.frameCompleted(buffer->status_ == Buffer::BufferError);
+	if (caps_.isCapture())
+		stats_.frameSequence(buf.sequence);
+
 	return buffer;
 }
 
@@ -1044,22 +1338,32 @@ Buffer *V4L2VideoDevice::dequeueBuffer()
  * \brief Slot to handle completed buffer events from the V4L2 video device
  * \param[in] notifier The event notifier
  *
- * When this slot is called, a Buffer has become available from the device, and
- * will be emitted through the bufferReady Signal.
+ * When this slot is called, one or more Buffers have become available from the
+ * device. All of them are dequeued and emitted through the bufferReady Signal,
+ * in the order they are dequeued from the device. Draining the device in one go
+ * avoids a round-trip through the event dispatcher for every completed buffer
+ * when the event loop falls behind.
  *
  * For Capture video devices the Buffer will contain valid data.
  * For Output video devices the Buffer can be considered empty.
  */
 void V4L2VideoDevice::bufferAvailable(EventNotifier *notifier)
 {
-	Buffer *buffer = dequeueBuffer();
-	if (!buffer)
-		return;
+	/*
+	 * The bufferReady handlers may stop the stream, which cancels all
+	 * queued buffers, so check for queued buffers at every iteration.
+	 */
+	while (queuedMask_.any()) {
+		Buffer *buffer = dequeueBuffer();
+		if (!buffer)
+			return;
 
-	LOG(V4L2, Debug) << "Buffer " << buffer->index() << " is available";
+		LOG(V4L2, Debug) << "Buffer " << buffer->index() << " is available";
 
-	/* Notify anyone listening to the device. */
-	bufferReady.emit(buffer);
+		/* Notify anyone listening to the device. */
+		TRACE_SCOPE(V4L2, "V4L2VideoDevice::bufferReady");
+		bufferReady.emit(buffer);
+	}
 }
 
 /**
@@ -1082,6 +1386,8 @@ int V4L2VideoDevice::streamOn()
 		return ret;
 	}
 
+	stats_.start(queuedMask_.none());
+
 	return 0;
 }
 
@@ -1106,22 +1412,40 @@ int V4L2VideoDevice::streamOff()
 		return ret;
 	}
 
+	stats_.stop(queuedMask_.count());
+
 	/* Send back all queued buffers. */
-	for (auto it : queuedBuffers_) {
-		unsigned int index = it.first;
-		Buffer *buffer = it.second;
+	for (unsigned int index = 0; index < queuedBuffers_.size(); ++index) {
+		if (!queuedMask_.test(index))
+			continue;
+
+		Buffer *buffer = queuedBuffers_[index];
+		queuedBuffers_[index] = nullptr;
+		queuedMask_.reset(index);
 
 		buffer->index_ = index;
 		buffer->cancel();
 		bufferReady.emit(buffer);
 	}
 
-	queuedBuffers_.clear();
 	fdEvent_->setEnabled(false);
 
 	return 0;
 }
 
+/**
+ * \brief Retrieve the frame delivery statistics of the video device
+ *
+ * The statistics are accumulated from the creation of the video device. Frame
+ * sequence gaps and underrun time are only meaningful for capture devices.
+ *
+ * \return The frame delivery statistics
+ */
+StreamStatistics V4L2VideoDevice::statistics() const
+{
+	return stats_.statistics();
+}
+
 /**
  * \brief Create a new video device instance from \a entity in media device
  * \a media
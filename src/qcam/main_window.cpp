@@ -214,7 +214,7 @@ void MainWindow::stopCapture()
 }
 
 void MainWindow::requestComplete(Request *request,
-				 const std::map<Stream *, Buffer *> &buffers)
+				 const Request::BufferMap &buffers)
 {
 	if (request->status() == Request::RequestCancelled)
 		return;
@@ -236,27 +236,12 @@ void MainWindow::requestComplete(Request *request,
 
 	display(buffer);
 
-	request = camera_->createRequest();
-	if (!request) {
-		std::cerr << "Can't create request" << std::endl;
-		return;
-	}
-
-	for (auto it = buffers.begin(); it != buffers.end(); ++it) {
-		Stream *stream = it->first;
-		Buffer *buffer = it->second;
-		unsigned int index = buffer->index();
-
-		std::unique_ptr<Buffer> newBuffer = stream->createBuffer(index);
-		if (!newBuffer) {
-			std::cerr << "Can't create buffer " << index << std::endl;
-			return;
-		}
-
-		request->addBuffer(std::move(newBuffer));
+	/* Requeue the request with the same buffers. */
+	request->reuse();
+	if (camera_->queueRequest(request) < 0) {
+		std::cerr << "Can't queue request" << std::endl;
+		delete request;
 	}
-
-	camera_->queueRequest(request);
 }
 
 int MainWindow::display(Buffer *buffer)
@@ -47,7 +47,7 @@ private:
 	void stopCapture();
 
 	void requestComplete(Request *request,
-			     const std::map<Stream *, Buffer *> &buffers);
+			     const Request::BufferMap &buffers);
 	int display(Buffer *buffer);
 
 	QString title_;
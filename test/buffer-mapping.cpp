@@ -0,0 +1,169 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * buffer-mapping.cpp - Plane memory mapping policy test
+ */
+
+#include <iostream>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <libcamera/buffer.h>
+
+#include "test.h"
+
+using namespace std;
+using namespace libcamera;
+
+static long minorFaults()
+{
+	struct rusage usage;
+
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_minflt;
+}
+
+class BufferMappingTest : public Test
+{
+protected:
+	int init()
+	{
+		fd_ = memfd_create("buffer-mapping", 0);
+		if (fd_ < 0) {
+			cout << "Failed to create memfd" << endl;
+			return TestSkip;
+		}
+
+		if (ftruncate(fd_, size_) < 0) {
+			cout << "Failed to resize memfd" << endl;
+			close(fd_);
+			return TestFail;
+		}
+
+		return TestPass;
+	}
+
+	/* Write to all pages of the plane and return the number of faults. */
+	long touch(Plane &plane)
+	{
+		long faults = minorFaults();
+
+		unsigned char *mem = static_cast<unsigned char *>(plane.mem());
+		for (unsigned int offset = 0; offset < size_; offset += pageSize_)
+			mem[offset] = offset;
+
+		return minorFaults() - faults;
+	}
+
+	int run()
+	{
+		BufferPool pool;
+		pool.createBuffers(1);
+		pool.buffers()[0].planes().emplace_back();
+		Plane &plane = pool.buffers()[0].planes()[0];
+
+		/* Planes with the MapNever policy shall never be mapped. */
+		pool.setMappingPolicy(MapNever);
+		MappingStatistics stats = Plane::statistics();
+
+		if (plane.setDmabuf(fd_, size_)) {
+			cout << "Failed to set dmabuf" << endl;
+			return TestFail;
+		}
+
+		if (plane.mem() || Plane::statistics().mmaps != stats.mmaps) {
+			cout << "Plane mapped with MapNever policy" << endl;
+			return TestFail;
+		}
+
+		/* Planes shall be mapped once on demand, and stay mapped. */
+		pool.setMappingPolicy(MapOnDemand);
+
+		if (Plane::statistics().mmaps != stats.mmaps) {
+			cout << "Plane mapped before access" << endl;
+			return TestFail;
+		}
+
+		long onDemandFaults = touch(plane);
+
+		for (unsigned int i = 0; i < 10; ++i)
+			touch(plane);
+
+		MappingStatistics current = Plane::statistics();
+		if (current.mmaps != stats.mmaps + 1 ||
+		    current.munmaps != stats.munmaps) {
+			cout << "Plane mapped " << current.mmaps - stats.mmaps
+			     << " times on demand" << endl;
+			return TestFail;
+		}
+
+		/* Read-only planes shall be remapped. */
+		pool.setMappingPolicy(MapReadOnly);
+
+		if (!plane.mem()) {
+			cout << "Failed to map plane read-only" << endl;
+			return TestFail;
+		}
+
+		current = Plane::statistics();
+		if (current.mmaps != stats.mmaps + 2 ||
+		    current.munmaps != stats.munmaps + 1) {
+			cout << "Read-only plane not remapped" << endl;
+			return TestFail;
+		}
+
+		/*
+		 * Prefaulted planes shall be mapped immediately, and accessing
+		 * them shall not cause more page faults than on-demand mapping.
+		 */
+		pool.setMappingPolicy(MapPrefault);
+
+		current = Plane::statistics();
+		if (current.mmaps != stats.mmaps + 3 ||
+		    current.munmaps != stats.munmaps + 2) {
+			cout << "Prefaulted plane not mapped" << endl;
+			return TestFail;
+		}
+
+		long prefaultFaults = touch(plane);
+
+		cout << "Page faults: " << onDemandFaults << " on demand, "
+		     << prefaultFaults << " prefaulted" << endl;
+
+		if (prefaultFaults >= onDemandFaults) {
+			cout << "Prefaulting didn't reduce page faults" << endl;
+			return TestFail;
+		}
+
+		/* Setting a new dmabuf shall release the mapping. */
+		if (plane.setDmabuf(fd_, size_)) {
+			cout << "Failed to set dmabuf" << endl;
+			return TestFail;
+		}
+
+		current = Plane::statistics();
+		if (current.mmaps != stats.mmaps + 4 ||
+		    current.munmaps != stats.munmaps + 3) {
+			cout << "Plane not remapped with new dmabuf" << endl;
+			return TestFail;
+		}
+
+		return TestPass;
+	}
+
+	void cleanup()
+	{
+		close(fd_);
+	}
+
+private:
+	static constexpr unsigned int pageSize_ = 4096;
+	static constexpr unsigned int size_ = 1024 * pageSize_;
+
+	int fd_;
+};
+
+TEST_REGISTER(BufferMappingTest)
@@ -0,0 +1,174 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * libcamera Camera API tests
+ *
+ * Test adding buffers to a stream while capturing.
+ */
+
+#include <errno.h>
+#include <iostream>
+
+#include "camera_test.h"
+
+using namespace std;
+
+namespace {
+
+class BufferGrowth : public CameraTest
+{
+protected:
+	unsigned int completeRequestsCount_;
+
+	void requestComplete(Request *request, const Request::BufferMap &buffers)
+	{
+		if (request->status() != Request::RequestComplete)
+			return;
+
+		completeRequestsCount_++;
+
+		request->reuse();
+		if (camera_->queueRequest(request))
+			delete request;
+	}
+
+	int queueRequests(Stream *stream, unsigned int first, unsigned int last)
+	{
+		for (unsigned int i = first; i < last; ++i) {
+			Request *request = camera_->createRequest();
+			if (!request) {
+				cout << "Failed to create request" << endl;
+				return TestFail;
+			}
+
+			std::unique_ptr<Buffer> buffer = stream->createBuffer(i);
+			if (!buffer) {
+				cout << "Failed to create buffer " << i << endl;
+				return TestFail;
+			}
+
+			if (request->addBuffer(std::move(buffer)) ||
+			    camera_->queueRequest(request)) {
+				cout << "Failed to queue request" << endl;
+				return TestFail;
+			}
+		}
+
+		return TestPass;
+	}
+
+	bool captureFrames(unsigned int count)
+	{
+		EventDispatcher *dispatcher = CameraManager::instance()->eventDispatcher();
+		unsigned int target = completeRequestsCount_ + count;
+
+		Timer timer;
+		timer.start(5000);
+		while (completeRequestsCount_ < target && timer.isRunning())
+			dispatcher->processEvents();
+
+		return completeRequestsCount_ >= target;
+	}
+
+	int init() override
+	{
+		int ret = CameraTest::init();
+		if (ret)
+			return ret;
+
+		config_ = camera_->generateConfiguration({ StreamRole::VideoRecording });
+		if (!config_ || config_->size() != 1) {
+			cout << "Failed to generate default configuration" << endl;
+			CameraTest::cleanup();
+			return TestFail;
+		}
+
+		return TestPass;
+	}
+
+	int run() override
+	{
+		StreamConfiguration &cfg = config_->at(0);
+		unsigned int bufferCount = cfg.bufferCount;
+		cfg.maxBufferCount = bufferCount * 2;
+
+		if (camera_->acquire()) {
+			cout << "Failed to acquire the camera" << endl;
+			return TestFail;
+		}
+
+		if (camera_->configure(config_.get())) {
+			cout << "Failed to set default configuration" << endl;
+			return TestFail;
+		}
+
+		if (camera_->allocateBuffers()) {
+			cout << "Failed to allocate buffers" << endl;
+			return TestFail;
+		}
+
+		Stream *stream = cfg.stream();
+
+		completeRequestsCount_ = 0;
+		camera_->requestCompleted.connect(this, &BufferGrowth::requestComplete);
+
+		if (camera_->start()) {
+			cout << "Failed to start camera" << endl;
+			return TestFail;
+		}
+
+		int ret = queueRequests(stream, 0, bufferCount);
+		if (ret)
+			return ret;
+
+		if (!captureFrames(bufferCount)) {
+			cout << "Failed to capture frames" << endl;
+			return TestFail;
+		}
+
+		/* Grow the stream to its maximum while capturing. */
+		if (camera_->addBuffers(stream, bufferCount)) {
+			cout << "Failed to add buffers" << endl;
+			return TestFail;
+		}
+
+		if (stream->buffers().size() != bufferCount * 2) {
+			cout << "Unexpected number of buffers "
+			     << stream->buffers().size() << endl;
+			return TestFail;
+		}
+
+		if (camera_->addBuffers(stream, 1) != -ENOSPC) {
+			cout << "Stream grown beyond its maximum" << endl;
+			return TestFail;
+		}
+
+		ret = queueRequests(stream, bufferCount, bufferCount * 2);
+		if (ret)
+			return ret;
+
+		if (!captureFrames(bufferCount * 4)) {
+			cout << "Failed to capture frames with added buffers" << endl;
+			return TestFail;
+		}
+
+		if (camera_->stop()) {
+			cout << "Failed to stop camera" << endl;
+			return TestFail;
+		}
+
+		if (camera_->freeBuffers()) {
+			cout << "Failed to free buffers" << endl;
+			return TestFail;
+		}
+
+		return TestPass;
+	}
+
+	std::unique_ptr<CameraConfiguration> config_;
+};
+
+} /* namespace */
+
+TEST_REGISTER(BufferGrowth);
@@ -8,6 +8,7 @@
  */
 
 #include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <numeric>
 #include <random>
@@ -252,7 +253,21 @@ public:
 
 		std::unique_ptr<Buffer> buffer = stream_->createBuffer({ dmabuf, -1, -1 });
 		request->addBuffer(move(buffer));
+
+		/*
+		 * Measure the time spent queuing requests, which includes
+		 * mapping the dmabuf to a buffer memory index, separately for
+		 * the first 40 requests that should hit the mapping cache and
+		 * for the last requests that thrash it.
+		 */
+		unsigned int phase = requestsQueued_ < 40 ? 0 : 1;
+
+		auto start = std::chrono::steady_clock::now();
 		camera_->queueRequest(request);
+		queueTime_[phase] += std::chrono::steady_clock::now() - start;
+		queueCount_[phase]++;
+
+		requestsQueued_++;
 	}
 
 protected:
@@ -361,6 +376,9 @@ protected:
 		int ret;
 
 		framesCaptured_ = 0;
+		requestsQueued_ = 0;
+		queueTime_[0] = queueTime_[1] = std::chrono::steady_clock::duration::zero();
+		queueCount_[0] = queueCount_[1] = 0;
 
 		if (camera_->start()) {
 			std::cout << "Failed to start camera" << std::endl;
@@ -384,6 +402,16 @@ protected:
 			  << bufferRemappings_.size() << " buffers remapped"
 			  << std::endl;
 
+		for (unsigned int i = 0; i < 2; ++i) {
+			if (!queueCount_[i])
+				continue;
+
+			auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(queueTime_[i]);
+			std::cout << "Queue time " << (i == 0 ? "with cached" : "with thrashed")
+				  << " mappings: " << ns.count() / queueCount_[i]
+				  << " ns per request" << std::endl;
+		}
+
 		if (framesCaptured_ < 60) {
 			std::cout << "Too few frames captured" << std::endl;
 			return TestFail;
@@ -419,6 +447,10 @@ private:
 	std::vector<unsigned int> bufferRemappings_;
 	unsigned int framesCaptured_;
 
+	unsigned int requestsQueued_;
+	std::chrono::steady_clock::duration queueTime_[2];
+	unsigned int queueCount_[2];
+
 	FrameSink sink_;
 };
 
@@ -0,0 +1,201 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * libcamera Camera API tests
+ *
+ * Test that persistent buffer pools are reused across compatible
+ * reconfigurations.
+ */
+
+#include <iostream>
+#include <vector>
+
+#include "camera_test.h"
+
+using namespace std;
+
+namespace {
+
+class BufferPersistent : public CameraTest
+{
+protected:
+	unsigned int completeRequestsCount_;
+
+	void requestComplete(Request *request, const Request::BufferMap &buffers)
+	{
+		if (request->status() != Request::RequestComplete)
+			return;
+
+		completeRequestsCount_++;
+
+		request->reuse();
+		if (camera_->queueRequest(request))
+			delete request;
+	}
+
+	/* Retrieve the dmabufs of all planes of the stream buffers. */
+	vector<int> dmabufs(Stream *stream)
+	{
+		vector<int> fds;
+
+		for (BufferMemory &mem : stream->buffers()) {
+			for (Plane &plane : mem.planes())
+				fds.push_back(plane.dmabuf());
+		}
+
+		return fds;
+	}
+
+	int configure(const Size &size)
+	{
+		StreamConfiguration &cfg = config_->at(0);
+
+		cfg.size = size;
+		if (config_->validate() != CameraConfiguration::Valid) {
+			cout << "Failed to validate configuration" << endl;
+			return TestFail;
+		}
+
+		if (camera_->configure(config_.get())) {
+			cout << "Failed to configure camera" << endl;
+			return TestFail;
+		}
+
+		/* Make the pool persistent the first time it is configured. */
+		cfg.stream()->bufferPool().setPersistent(true);
+
+		if (camera_->allocateBuffers()) {
+			cout << "Failed to allocate buffers" << endl;
+			return TestFail;
+		}
+
+		return TestPass;
+	}
+
+	int capture()
+	{
+		StreamConfiguration &cfg = config_->at(0);
+		Stream *stream = cfg.stream();
+
+		if (camera_->start()) {
+			cout << "Failed to start camera" << endl;
+			return TestFail;
+		}
+
+		for (unsigned int i = 0; i < cfg.bufferCount; ++i) {
+			Request *request = camera_->createRequest();
+			if (!request ||
+			    request->addBuffer(stream->createBuffer(i)) ||
+			    camera_->queueRequest(request)) {
+				cout << "Failed to queue request" << endl;
+				return TestFail;
+			}
+		}
+
+		EventDispatcher *dispatcher = CameraManager::instance()->eventDispatcher();
+		unsigned int target = completeRequestsCount_ + cfg.bufferCount * 2;
+
+		Timer timer;
+		timer.start(5000);
+		while (completeRequestsCount_ < target && timer.isRunning())
+			dispatcher->processEvents();
+
+		if (camera_->stop()) {
+			cout << "Failed to stop camera" << endl;
+			return TestFail;
+		}
+
+		if (completeRequestsCount_ < target) {
+			cout << "Failed to capture frames" << endl;
+			return TestFail;
+		}
+
+		return TestPass;
+	}
+
+	int init() override
+	{
+		int ret = CameraTest::init();
+		if (ret)
+			return ret;
+
+		config_ = camera_->generateConfiguration({ StreamRole::VideoRecording });
+		if (!config_ || config_->size() != 1) {
+			cout << "Failed to generate default configuration" << endl;
+			CameraTest::cleanup();
+			return TestFail;
+		}
+
+		return TestPass;
+	}
+
+	int run() override
+	{
+		const Size largeSize = config_->at(0).size;
+		const Size smallSize = { largeSize.width / 2, largeSize.height / 2 };
+		int ret;
+
+		completeRequestsCount_ = 0;
+		camera_->requestCompleted.connect(this, &BufferPersistent::requestComplete);
+
+		if (camera_->acquire()) {
+			cout << "Failed to acquire the camera" << endl;
+			return TestFail;
+		}
+
+		/* Allocate buffers for the largest size and capture. */
+		ret = configure(largeSize);
+		if (ret)
+			return ret;
+
+		ret = capture();
+		if (ret)
+			return ret;
+
+		Stream *stream = config_->at(0).stream();
+		vector<int> fds = dmabufs(stream);
+		if (fds.empty()) {
+			cout << "No buffer allocated" << endl;
+			return TestFail;
+		}
+
+		/*
+		 * Switch to a smaller size and back, the buffers shall be
+		 * reused without reallocation.
+		 */
+		for (const Size &size : { smallSize, largeSize }) {
+			if (camera_->freeBuffers()) {
+				cout << "Failed to free buffers" << endl;
+				return TestFail;
+			}
+
+			ret = configure(size);
+			if (ret)
+				return ret;
+
+			if (dmabufs(stream) != fds) {
+				cout << "Persistent buffers reallocated for "
+				     << size.toString() << endl;
+				return TestFail;
+			}
+
+			ret = capture();
+			if (ret)
+				return ret;
+		}
+
+		if (camera_->freeBuffers()) {
+			cout << "Failed to free buffers" << endl;
+			return TestFail;
+		}
+
+		return TestPass;
+	}
+
+	std::unique_ptr<CameraConfiguration> config_;
+};
+
+} /* namespace */
+
+TEST_REGISTER(BufferPersistent);
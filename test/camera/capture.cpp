@@ -27,7 +27,7 @@ protected:
 		completeBuffersCount_++;
 	}
 
-	void requestComplete(Request *request, const std::map<Stream *, Buffer *> &buffers)
+	void requestComplete(Request *request, const Request::BufferMap &buffers)
 	{
 		if (request->status() != Request::RequestComplete)
 			return;
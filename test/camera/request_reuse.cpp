@@ -0,0 +1,167 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * libcamera Camera API tests
+ *
+ * Test that a continuous capture with reused requests doesn't allocate memory.
+ */
+
+#include <iostream>
+
+#include "allocations.h"
+#include "camera_test.h"
+
+using namespace std;
+
+namespace {
+
+class RequestReuse : public CameraTest
+{
+protected:
+	unsigned int completeRequestsCount_;
+
+	void requestComplete(Request *request, const Request::BufferMap &buffers)
+	{
+		if (request->status() != Request::RequestComplete)
+			return;
+
+		completeRequestsCount_++;
+
+		request->reuse();
+		if (camera_->queueRequest(request))
+			delete request;
+	}
+
+	bool captureFrames(unsigned int count)
+	{
+		EventDispatcher *dispatcher = CameraManager::instance()->eventDispatcher();
+		unsigned int target = completeRequestsCount_ + count;
+
+		Timer timer;
+		timer.start(5000);
+		while (completeRequestsCount_ < target && timer.isRunning())
+			dispatcher->processEvents();
+
+		return completeRequestsCount_ >= target;
+	}
+
+	int init() override
+	{
+		int ret = CameraTest::init();
+		if (ret)
+			return ret;
+
+		config_ = camera_->generateConfiguration({ StreamRole::VideoRecording });
+		if (!config_ || config_->size() != 1) {
+			cout << "Failed to generate default configuration" << endl;
+			CameraTest::cleanup();
+			return TestFail;
+		}
+
+		return TestPass;
+	}
+
+	int run() override
+	{
+		StreamConfiguration &cfg = config_->at(0);
+
+		if (camera_->acquire()) {
+			cout << "Failed to acquire the camera" << endl;
+			return TestFail;
+		}
+
+		if (camera_->configure(config_.get())) {
+			cout << "Failed to set default configuration" << endl;
+			return TestFail;
+		}
+
+		if (camera_->allocateBuffers()) {
+			cout << "Failed to allocate buffers" << endl;
+			return TestFail;
+		}
+
+		Stream *stream = cfg.stream();
+		std::vector<Request *> requests;
+		for (unsigned int i = 0; i < cfg.bufferCount; ++i) {
+			Request *request = camera_->createRequest();
+			if (!request) {
+				cout << "Failed to create request" << endl;
+				return TestFail;
+			}
+
+			std::unique_ptr<Buffer> buffer = stream->createBuffer(i);
+			if (!buffer) {
+				cout << "Failed to create buffer " << i << endl;
+				return TestFail;
+			}
+
+			if (request->addBuffer(std::move(buffer))) {
+				cout << "Failed to associating buffer with request" << endl;
+				return TestFail;
+			}
+
+			requests.push_back(request);
+		}
+
+		completeRequestsCount_ = 0;
+
+		camera_->requestCompleted.connect(this, &RequestReuse::requestComplete);
+
+		if (camera_->start()) {
+			cout << "Failed to start camera" << endl;
+			return TestFail;
+		}
+
+		for (Request *request : requests) {
+			if (camera_->queueRequest(request)) {
+				cout << "Failed to queue request" << endl;
+				return TestFail;
+			}
+		}
+
+		/*
+		 * Cycle all requests a few times before measuring, to let lazily
+		 * allocated resources reach their steady state.
+		 */
+		if (!captureFrames(cfg.bufferCount * 2)) {
+			cout << "Failed to capture frames" << endl;
+			return TestFail;
+		}
+
+		const unsigned int frames = cfg.bufferCount * 4;
+
+		AllocationCounter allocations;
+
+		if (!captureFrames(frames)) {
+			cout << "Failed to capture frames" << endl;
+			return TestFail;
+		}
+
+		unsigned int count = allocations.count();
+
+		if (camera_->stop()) {
+			cout << "Failed to stop camera" << endl;
+			return TestFail;
+		}
+
+		if (camera_->freeBuffers()) {
+			cout << "Failed to free buffers" << endl;
+			return TestFail;
+		}
+
+		if (count) {
+			cout << count << " allocations for " << frames
+			     << " frames captured with reused requests" << endl;
+			return TestFail;
+		}
+
+		return TestPass;
+	}
+
+	std::unique_ptr<CameraConfiguration> config_;
+};
+
+} /* namespace */
+
+TEST_REGISTER(RequestReuse);
@@ -0,0 +1,158 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * libcamera Camera API tests
+ *
+ * Test request latency tracing.
+ */
+
+#include <iostream>
+
+#include "camera_test.h"
+
+using namespace std;
+
+namespace {
+
+class RequestTracing : public CameraTest
+{
+protected:
+	unsigned int completeRequestsCount_;
+	bool traceValid_;
+
+	void requestComplete(Request *request, const Request::BufferMap &buffers)
+	{
+		if (request->status() != Request::RequestComplete)
+			return;
+
+		completeRequestsCount_++;
+
+		/* Trace points shall be reached in order. */
+		uint64_t previous = 0;
+		for (unsigned int i = 0; i < Request::TracePointCount; ++i) {
+			Request::TracePoint point = static_cast<Request::TracePoint>(i);
+			uint64_t timestamp = request->traceTimestamp(point);
+
+			if (!timestamp || timestamp < previous) {
+				cout << "Invalid trace point " << i << " timestamp "
+				     << timestamp << endl;
+				traceValid_ = false;
+			}
+
+			previous = timestamp;
+		}
+
+		request->reuse();
+		if (camera_->queueRequest(request))
+			delete request;
+	}
+
+	int init() override
+	{
+		int ret = CameraTest::init();
+		if (ret)
+			return ret;
+
+		config_ = camera_->generateConfiguration({ StreamRole::VideoRecording });
+		if (!config_ || config_->size() != 1) {
+			cout << "Failed to generate default configuration" << endl;
+			CameraTest::cleanup();
+			return TestFail;
+		}
+
+		return TestPass;
+	}
+
+	int run() override
+	{
+		StreamConfiguration &cfg = config_->at(0);
+
+		if (camera_->acquire()) {
+			cout << "Failed to acquire the camera" << endl;
+			return TestFail;
+		}
+
+		if (camera_->configure(config_.get())) {
+			cout << "Failed to set default configuration" << endl;
+			return TestFail;
+		}
+
+		if (camera_->allocateBuffers()) {
+			cout << "Failed to allocate buffers" << endl;
+			return TestFail;
+		}
+
+		camera_->setTracing(true);
+
+		completeRequestsCount_ = 0;
+		traceValid_ = true;
+		camera_->requestCompleted.connect(this, &RequestTracing::requestComplete);
+
+		if (camera_->start()) {
+			cout << "Failed to start camera" << endl;
+			return TestFail;
+		}
+
+		Stream *stream = cfg.stream();
+		for (unsigned int i = 0; i < cfg.bufferCount; ++i) {
+			Request *request = camera_->createRequest();
+			if (!request ||
+			    request->addBuffer(stream->createBuffer(i)) ||
+			    camera_->queueRequest(request)) {
+				cout << "Failed to queue request" << endl;
+				return TestFail;
+			}
+		}
+
+		EventDispatcher *dispatcher = CameraManager::instance()->eventDispatcher();
+		const unsigned int frames = cfg.bufferCount * 4;
+
+		Timer timer;
+		timer.start(5000);
+		while (completeRequestsCount_ < frames && timer.isRunning())
+			dispatcher->processEvents();
+
+		if (camera_->stop()) {
+			cout << "Failed to stop camera" << endl;
+			return TestFail;
+		}
+
+		if (camera_->freeBuffers()) {
+			cout << "Failed to free buffers" << endl;
+			return TestFail;
+		}
+
+		if (completeRequestsCount_ < frames) {
+			cout << "Failed to capture frames" << endl;
+			return TestFail;
+		}
+
+		if (!traceValid_)
+			return TestFail;
+
+		for (unsigned int i = 0; i < LatencyStageCount; ++i) {
+			LatencyStage stage = static_cast<LatencyStage>(i);
+			LatencyStatistics stats = camera_->latency(stage);
+
+			if (stats.count < frames ||
+			    stats.p50 > stats.p99 || stats.p99 > stats.max) {
+				cout << "Invalid latency statistics for stage "
+				     << i << endl;
+				return TestFail;
+			}
+
+			cout << "Stage " << i << ": p50 " << stats.p50
+			     << " ns, p99 " << stats.p99 << " ns, max "
+			     << stats.max << " ns" << endl;
+		}
+
+		return TestPass;
+	}
+
+	std::unique_ptr<CameraConfiguration> config_;
+};
+
+} /* namespace */
+
+TEST_REGISTER(RequestTracing);
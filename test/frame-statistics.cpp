@@ -0,0 +1,116 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * frame-statistics.cpp - Frame delivery statistics tracking test
+ */
+
+#include <iostream>
+#include <unistd.h>
+
+#include <libcamera/stream.h>
+
+#include "frame_statistics.h"
+#include "test.h"
+
+using namespace std;
+using namespace libcamera;
+
+class FrameStatisticsTest : public Test
+{
+protected:
+	int run()
+	{
+		FrameStatistics tracker;
+		StreamStatistics stats = tracker.statistics();
+
+		if (stats.frames || stats.droppedFrames || stats.underrunTime ||
+		    stats.errors || stats.cancelled) {
+			cout << "Initial statistics are not zero" << endl;
+			return TestFail;
+		}
+
+		/*
+		 * Complete frames with gaps of 2 and 3 sequence numbers, one
+		 * of them with an error.
+		 */
+		tracker.start(false);
+
+		const uint32_t sequences[] = { 0, 1, 4, 5, 9 };
+		for (uint32_t sequence : sequences) {
+			tracker.frameCompleted(sequence == 5);
+			tracker.frameSequence(sequence);
+		}
+
+		stats = tracker.statistics();
+		if (stats.frames != 5 || stats.droppedFrames != 5 ||
+		    stats.errors != 1) {
+			cout << "Invalid statistics " << stats.frames << " frames, "
+			     << stats.droppedFrames << " dropped, "
+			     << stats.errors << " errors" << endl;
+			return TestFail;
+		}
+
+		/* Underruns are only accounted while streaming. */
+		tracker.startUnderrun();
+		usleep(20000);
+		tracker.stopUnderrun();
+
+		tracker.stop(2);
+
+		stats = tracker.statistics();
+		if (stats.underrunTime < 20000000ULL) {
+			cout << "Invalid underrun time " << stats.underrunTime
+			     << " ns" << endl;
+			return TestFail;
+		}
+
+		if (stats.cancelled != 2) {
+			cout << "Invalid cancelled count " << stats.cancelled
+			     << endl;
+			return TestFail;
+		}
+
+		uint64_t underrunTime = stats.underrunTime;
+
+		tracker.startUnderrun();
+		usleep(20000);
+		tracker.stopUnderrun();
+
+		stats = tracker.statistics();
+		if (stats.underrunTime != underrunTime) {
+			cout << "Underrun accounted while not streaming" << endl;
+			return TestFail;
+		}
+
+		/*
+		 * Sequence numbers restart from zero at stream on, without
+		 * being counted as dropped frames. A session starting with no
+		 * buffer queued starts with an underrun, and a gap at the
+		 * beginning of the session is counted.
+		 */
+		tracker.start(true);
+		usleep(20000);
+		tracker.stopUnderrun();
+
+		tracker.frameCompleted(false);
+		tracker.frameSequence(3);
+
+		stats = tracker.statistics();
+		if (stats.frames != 6 || stats.droppedFrames != 8) {
+			cout << "Invalid statistics after restart, "
+			     << stats.frames << " frames, "
+			     << stats.droppedFrames << " dropped" << endl;
+			return TestFail;
+		}
+
+		if (stats.underrunTime - underrunTime < 20000000ULL) {
+			cout << "Underrun at stream on not accounted" << endl;
+			return TestFail;
+		}
+
+		return TestPass;
+	}
+};
+
+TEST_REGISTER(FrameStatisticsTest)
@@ -7,6 +7,7 @@
 
 #include <iostream>
 #include <string.h>
+#include <unistd.h>
 
 #include "ipa_module.h"
 
@@ -67,6 +68,20 @@ protected:
 		if (count < 0)
 			return TestFail;
 
+		/* Modules built for a different API version shall be rejected. */
+		const char *mismatchPath = "test/ipa/ipa_version_mismatch.so";
+		if (access(mismatchPath, R_OK)) {
+			cerr << "IPA module " << mismatchPath << " not found" << endl;
+			return TestFail;
+		}
+
+		IPAModule mismatch(mismatchPath);
+		if (mismatch.isValid()) {
+			cerr << "IPA module with mismatched API version accepted"
+			     << endl;
+			return TestFail;
+		}
+
 		return TestPass;
 	}
 };
@@ -0,0 +1,35 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * ipa_version_mismatch.cpp - IPA module built for a different API version
+ */
+
+#include <libcamera/ipa/ipa_interface.h>
+#include <libcamera/ipa/ipa_module_info.h>
+
+namespace libcamera {
+
+class IPAVersionMismatch : public IPAInterface
+{
+public:
+	int init() { return 0; }
+	void processEvent(const IPAOperationData &event) {}
+};
+
+extern "C" {
+const struct IPAModuleInfo ipaModuleInfo = {
+	IPA_MODULE_API_VERSION - 1,
+	0,
+	"PipelineHandlerVimc",
+	"IPA module API version mismatch test",
+	"GPL-2.0-or-later",
+};
+
+IPAInterface *ipaCreate()
+{
+	return new IPAVersionMismatch();
+}
+};
+
+}; /* namespace libcamera */
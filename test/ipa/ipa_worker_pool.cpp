@@ -0,0 +1,253 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * ipa_worker_pool.cpp - IPA proxy creation latency with and without warm workers
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <dirent.h>
+#include <fstream>
+#include <iostream>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+#include <libcamera/camera_manager.h>
+#include <libcamera/event_dispatcher.h>
+#include <libcamera/ipa/ipa_interface.h>
+#include <libcamera/timer.h>
+
+#include "ipa_module.h"
+#include "ipa_proxy.h"
+#include "test.h"
+
+using namespace std;
+using namespace libcamera;
+
+class IPAWorkerPoolTest : public Test
+{
+public:
+	IPAWorkerPoolTest()
+		: module_(nullptr), factory_(nullptr), received_(false)
+	{
+	}
+
+protected:
+	static constexpr unsigned int NumIterations = 5;
+
+	int init()
+	{
+		setenv("LIBCAMERA_IPA_PROXY_PATH", "src/libcamera/proxy/worker", 1);
+
+		module_ = new IPAModule("src/ipa/ipa_dummy_isolate.so");
+		if (!module_->isValid()) {
+			cerr << "Failed to load isolated IPA module" << endl;
+			return TestFail;
+		}
+
+		for (IPAProxyFactory *factory : IPAProxyFactory::factories()) {
+			if (!strcmp(factory->name().c_str(), "IPAProxyLinux"))
+				factory_ = factory;
+		}
+
+		if (!factory_) {
+			cerr << "Linux IPA proxy not found" << endl;
+			return TestFail;
+		}
+
+		dispatcher_ = CameraManager::instance()->eventDispatcher();
+
+		return TestPass;
+	}
+
+	void cleanup()
+	{
+		if (factory_)
+			factory_->prepare(module_, 0);
+		delete module_;
+	}
+
+	void wait(unsigned int ms)
+	{
+		Timer timer;
+		timer.start(ms);
+		while (timer.isRunning())
+			dispatcher_->processEvents();
+	}
+
+	/*
+	 * Measure the time from the proxy creation until the IPA has handled
+	 * its first event.
+	 */
+	int measure(chrono::microseconds *latency)
+	{
+		IPAOperationData event;
+		event.operation = 1;
+		event.data = { 42 };
+
+		received_ = false;
+
+		auto start = chrono::steady_clock::now();
+
+		unique_ptr<IPAProxy> proxy = factory_->create(module_);
+		if (!proxy->isValid()) {
+			cerr << "Failed to create proxy" << endl;
+			return TestFail;
+		}
+
+		proxy->queueFrameAction.connect(this, &IPAWorkerPoolTest::queueFrameAction);
+		proxy->init();
+		proxy->processEvent(event);
+
+		Timer timeout;
+		timeout.start(5000);
+		while (!received_ && timeout.isRunning())
+			dispatcher_->processEvents();
+
+		if (!received_) {
+			cerr << "Timeout waiting for IPA action" << endl;
+			return TestFail;
+		}
+
+		*latency = chrono::duration_cast<chrono::microseconds>(
+			chrono::steady_clock::now() - start);
+
+		if (action_.operation != event.operation || action_.data != event.data) {
+			cerr << "Invalid IPA action" << endl;
+			return TestFail;
+		}
+
+		return TestPass;
+	}
+
+	int measureMedian(const char *name, chrono::microseconds *median)
+	{
+		vector<chrono::microseconds> latencies;
+
+		for (unsigned int i = 0; i < NumIterations; ++i) {
+			chrono::microseconds latency;
+			if (measure(&latency))
+				return TestFail;
+			latencies.push_back(latency);
+
+			/* Let the pool replace and start the worker that got used. */
+			wait(300);
+		}
+
+		sort(latencies.begin(), latencies.end());
+		*median = latencies[latencies.size() / 2];
+
+		cout << name << " workers: median IPA open latency "
+		     << median->count() << " us" << endl;
+
+		return TestPass;
+	}
+
+	pid_t findWorker()
+	{
+		DIR *dir = opendir("/proc");
+		if (!dir)
+			return -1;
+
+		pid_t worker = -1;
+		struct dirent *ent;
+		while ((ent = readdir(dir)) != nullptr) {
+			pid_t pid = atoi(ent->d_name);
+			if (pid <= 0)
+				continue;
+
+			ifstream stat("/proc/" + string(ent->d_name) + "/stat");
+			string comm, state;
+			pid_t ppid = -1;
+			stat >> pid >> comm >> state >> ppid;
+			if (ppid == getpid()) {
+				worker = pid;
+				break;
+			}
+		}
+
+		closedir(dir);
+		return worker;
+	}
+
+	int testDeadWorker()
+	{
+		/*
+		 * Kill the pool worker without giving the process manager a
+		 * chance to notice, and check that the proxy replaces it.
+		 */
+		pid_t pid = findWorker();
+		if (pid < 0) {
+			cerr << "Pool worker not found" << endl;
+			return TestFail;
+		}
+
+		siginfo_t info;
+		if (kill(pid, SIGKILL) ||
+		    waitid(P_PID, pid, &info, WEXITED | WNOWAIT)) {
+			cerr << "Failed to kill pool worker" << endl;
+			return TestFail;
+		}
+
+		chrono::microseconds latency;
+		if (measure(&latency)) {
+			cerr << "Dead pool worker not replaced" << endl;
+			return TestFail;
+		}
+
+		return TestPass;
+	}
+
+	int run()
+	{
+		chrono::microseconds cold;
+		chrono::microseconds warm;
+
+		if (measureMedian("Cold", &cold))
+			return TestFail;
+
+		factory_->prepare(module_, 1);
+		wait(300);
+
+		if (measureMedian("Warm", &warm))
+			return TestFail;
+
+		/*
+		 * Warm workers skip the process startup and the IPA module
+		 * loading, which account for most of the cold latency. Use a
+		 * large margin to avoid failures on loaded systems.
+		 */
+		if (warm * 2 > cold) {
+			cerr << "Warm workers don't lower the IPA open latency enough"
+			     << endl;
+			return TestFail;
+		}
+
+		if (testDeadWorker())
+			return TestFail;
+
+		return TestPass;
+	}
+
+private:
+	void queueFrameAction(unsigned int frame, const IPAOperationData &action)
+	{
+		action_ = action;
+		received_ = true;
+	}
+
+	IPAModule *module_;
+	IPAProxyFactory *factory_;
+	EventDispatcher *dispatcher_;
+
+	IPAOperationData action_;
+	bool received_;
+};
+
+TEST_REGISTER(IPAWorkerPoolTest)
@@ -0,0 +1,481 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * ring_channel.cpp - Shared memory ring IPC channel test and benchmark
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <fcntl.h>
+#include <iomanip>
+#include <iostream>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <vector>
+
+#include <libcamera/camera_manager.h>
+#include <libcamera/event_dispatcher.h>
+#include <libcamera/timer.h>
+
+#include "ipc_ring_channel.h"
+#include "ipc_unixsocket.h"
+#include "slave_process.h"
+#include "test.h"
+
+#define CMD_CLOSE	0
+#define CMD_ECHO	1
+
+using namespace std;
+using namespace libcamera;
+
+/* Small enough to exercise wrapping and the inline fallback. */
+static constexpr size_t TestRingSize = 64 * 1024;
+
+template<typename Transport>
+Transport *createTransport();
+
+template<>
+IPCUnixSocket *createTransport<IPCUnixSocket>()
+{
+	return new IPCUnixSocket();
+}
+
+template<>
+IPCRingChannel *createTransport<IPCRingChannel>()
+{
+	return new IPCRingChannel(TestRingSize);
+}
+
+template<typename Transport>
+class RingChannelSlave
+{
+public:
+	RingChannelSlave()
+		: ipc_(createTransport<Transport>()), exitCode_(EXIT_FAILURE),
+		  exit_(false)
+	{
+		dispatcher_ = CameraManager::instance()->eventDispatcher();
+		ipc_->readyRead.connect(this, &RingChannelSlave::readyRead);
+	}
+
+	~RingChannelSlave()
+	{
+		delete ipc_;
+	}
+
+	int run(int fd)
+	{
+		if (ipc_->bind(fd)) {
+			cerr << "Failed to connect to IPC channel" << endl;
+			return EXIT_FAILURE;
+		}
+
+		while (!exit_)
+			dispatcher_->processEvents();
+
+		ipc_->close();
+
+		return exitCode_;
+	}
+
+private:
+	void readyRead(Transport *ipc)
+	{
+		if (ipc->receive(&message_)) {
+			cerr << "Receive message failed" << endl;
+			stop(EXIT_FAILURE);
+			return;
+		}
+
+		if (message_.data.empty() || message_.data[0] == CMD_CLOSE) {
+			stop(EXIT_SUCCESS);
+			return;
+		}
+
+		/* Echo the message back, including the file descriptors. */
+		int ret = ipc_->send(message_);
+
+		for (int32_t fd : message_.fds)
+			close(fd);
+
+		if (ret) {
+			cerr << "Echo failed" << endl;
+			stop(EXIT_FAILURE);
+		}
+	}
+
+	void stop(int code)
+	{
+		exitCode_ = code;
+		exit_ = true;
+	}
+
+	Transport *ipc_;
+	typename Transport::Payload message_;
+	EventDispatcher *dispatcher_;
+	int exitCode_;
+	bool exit_;
+};
+
+template<typename Transport>
+class TransportMaster
+{
+public:
+	TransportMaster(const char *name)
+		: name_(name), ipc_(createTransport<Transport>()),
+		  received_(false)
+	{
+		dispatcher_ = CameraManager::instance()->eventDispatcher();
+		ipc_->readyRead.connect(this, &TransportMaster::readyRead);
+	}
+
+	~TransportMaster()
+	{
+		delete ipc_;
+	}
+
+	Transport *ipc() { return ipc_; }
+
+	int start()
+	{
+		int fd = ipc_->create();
+		if (fd < 0)
+			return TestFail;
+
+		return slave_.start({ name_, std::to_string(fd) });
+	}
+
+	int stop()
+	{
+		typename Transport::Payload message;
+		message.data.push_back(CMD_CLOSE);
+		if (ipc_->send(message)) {
+			cerr << "Closing IPC channel failed" << endl;
+			return TestFail;
+		}
+
+		ipc_->close();
+
+		return slave_.wait();
+	}
+
+	/* Wait for the response to a message sent by the caller. */
+	int wait()
+	{
+		Timer timeout;
+		timeout.start(1000);
+
+		while (!received_ && timeout.isRunning())
+			dispatcher_->processEvents();
+
+		if (!received_) {
+			cerr << name_ << ": timeout waiting for response" << endl;
+			return TestFail;
+		}
+
+		received_ = false;
+		return TestPass;
+	}
+
+	int call(const typename Transport::Payload &message)
+	{
+		received_ = false;
+
+		if (ipc_->send(message)) {
+			cerr << name_ << ": failed to send message" << endl;
+			return TestFail;
+		}
+
+		if (wait())
+			return TestFail;
+
+		if (response_.data != message.data) {
+			cerr << name_ << ": invalid response" << endl;
+			return TestFail;
+		}
+
+		return TestPass;
+	}
+
+	int benchmark(size_t size)
+	{
+		static constexpr unsigned int NumMessages = 5000;
+
+		typename Transport::Payload message;
+		message.data.resize(size);
+		message.data[0] = CMD_ECHO;
+
+		vector<chrono::nanoseconds> latencies;
+		latencies.reserve(NumMessages);
+
+		auto begin = chrono::steady_clock::now();
+
+		for (unsigned int i = 0; i < NumMessages; ++i) {
+			message.data[1] = i;
+
+			auto start = chrono::steady_clock::now();
+
+			if (call(message))
+				return TestFail;
+
+			latencies.push_back(chrono::steady_clock::now() - start);
+		}
+
+		chrono::duration<double> elapsed = chrono::steady_clock::now() - begin;
+		sort(latencies.begin(), latencies.end());
+
+		/* Each round trip transfers the message in both directions. */
+		double throughput = 2.0 * size * NumMessages / elapsed.count()
+				  / (1024 * 1024);
+
+		cout << setw(6) << name_ << " " << setw(6) << size
+		     << " bytes: median "
+		     << latencies[latencies.size() / 2].count() << " ns, p99 "
+		     << latencies[latencies.size() * 99 / 100].count() << " ns, "
+		     << static_cast<unsigned int>(throughput) << " MiB/s" << endl;
+
+		return TestPass;
+	}
+
+	const typename Transport::Payload &response() const { return response_; }
+
+private:
+	void readyRead(Transport *ipc)
+	{
+		for (int32_t fd : response_.fds)
+			close(fd);
+
+		if (ipc->receive(&response_)) {
+			cerr << name_ << ": receive message failed" << endl;
+			return;
+		}
+
+		received_ = true;
+	}
+
+	const char *name_;
+	Transport *ipc_;
+	EventDispatcher *dispatcher_;
+	SlaveProcess slave_;
+
+	typename Transport::Payload response_;
+	bool received_;
+};
+
+class RingChannelTest : public Test
+{
+protected:
+	int testFds(TransportMaster<IPCRingChannel> &master)
+	{
+		int fds[2];
+		if (pipe2(fds, O_CLOEXEC))
+			return TestFail;
+
+		IPCRingChannel::Payload message;
+		message.data = { CMD_ECHO, 1, 2, 3 };
+		message.fds.push_back(fds[1]);
+
+		int ret = master.call(message);
+		close(fds[1]);
+		if (ret) {
+			close(fds[0]);
+			return TestFail;
+		}
+
+		/* The echoed descriptor must refer to the same pipe. */
+		const IPCRingChannel::Payload &response = master.response();
+		char byte = 'x';
+		char readByte = 0;
+		if (response.fds.size() != 1 ||
+		    write(response.fds[0], &byte, 1) != 1 ||
+		    read(fds[0], &readByte, 1) != 1 || readByte != byte) {
+			cerr << "File descriptor not transferred" << endl;
+			close(fds[0]);
+			return TestFail;
+		}
+
+		close(fds[0]);
+		return TestPass;
+	}
+
+	int testInline(TransportMaster<IPCRingChannel> &master)
+	{
+		/* Messages larger than the ring are sent through the socket. */
+		IPCRingChannel::Payload message;
+		message.data.resize(TestRingSize + 4096);
+		for (unsigned int i = 0; i < message.data.size(); ++i)
+			message.data[i] = i * 7 + 1;
+
+		return master.call(message);
+	}
+
+	int testReserve(TransportMaster<IPCRingChannel> &master)
+	{
+		/* Fill the ring several times to exercise wrapping. */
+		for (unsigned int i = 0; i < 64; ++i) {
+			size_t size = 1000 + i * 313;
+			uint8_t *data = static_cast<uint8_t *>(master.ipc()->reserve(size));
+			if (!data) {
+				cerr << "Failed to reserve " << size << " bytes" << endl;
+				return TestFail;
+			}
+
+			data[0] = CMD_ECHO;
+			memset(data + 1, i, size - 1);
+
+			if (master.ipc()->commit({}) || master.wait())
+				return TestFail;
+
+			const vector<uint8_t> &response = master.response().data;
+			if (response.size() != size || response[0] != CMD_ECHO ||
+			    response[size - 1] != i) {
+				cerr << "Invalid response to reserved message" << endl;
+				return TestFail;
+			}
+		}
+
+		return TestPass;
+	}
+
+	void doorbellReadyRead(IPCRingChannel *ipc)
+	{
+		IPCRingChannel::Payload message;
+		if (ipc->receive(&message) || message.data.size() != sizeof(uint32_t)) {
+			received_.push_back(UINT32_MAX);
+			return;
+		}
+
+		uint32_t sequence;
+		memcpy(&sequence, message.data.data(), sizeof(sequence));
+		received_.push_back(sequence);
+	}
+
+	int testDoorbellFailure()
+	{
+		/*
+		 * Fill the socket until sending the doorbell fails, and check that
+		 * the entry committed to the ring is withdrawn so that the
+		 * following messages are received in order.
+		 */
+		IPCRingChannel sender(TestRingSize);
+		IPCRingChannel receiver(TestRingSize);
+		receiver.readyRead.connect(this, &RingChannelTest::doorbellReadyRead);
+
+		int fd = sender.create();
+		if (fd < 0 || receiver.bind(fd))
+			return TestFail;
+
+		static constexpr uint32_t MaxMessages = 1000;
+
+		uint32_t sequence;
+		for (sequence = 0; sequence < MaxMessages; ++sequence) {
+			void *data = sender.reserve(sizeof(sequence));
+			if (!data)
+				break;
+
+			memcpy(data, &sequence, sizeof(sequence));
+			if (sender.commit({}))
+				break;
+		}
+
+		if (!sequence || sequence == MaxMessages) {
+			cerr << "Failed to fill the doorbell socket" << endl;
+			return TestFail;
+		}
+
+		EventDispatcher *dispatcher = CameraManager::instance()->eventDispatcher();
+		Timer timeout;
+		timeout.start(1000);
+
+		received_.clear();
+		while (received_.size() < sequence && timeout.isRunning())
+			dispatcher->processEvents();
+
+		/*
+		 * Send one more message once the socket has been drained. It
+		 * must be received in place of the withdrawn one.
+		 */
+		void *data = sender.reserve(sizeof(MaxMessages));
+		if (!data)
+			return TestFail;
+
+		memcpy(data, &MaxMessages, sizeof(MaxMessages));
+		if (sender.commit({}))
+			return TestFail;
+
+		while (received_.size() < sequence + 1 && timeout.isRunning())
+			dispatcher->processEvents();
+
+		if (received_.size() != sequence + 1) {
+			cerr << "Received " << received_.size() << " messages, expected "
+			     << sequence + 1 << endl;
+			return TestFail;
+		}
+
+		for (uint32_t i = 0; i <= sequence; ++i) {
+			uint32_t expected = i < sequence ? i : MaxMessages;
+			if (received_[i] != expected) {
+				cerr << "Message " << i << " out of sequence" << endl;
+				return TestFail;
+			}
+		}
+
+		return TestPass;
+	}
+
+	int run()
+	{
+		if (testDoorbellFailure())
+			return TestFail;
+
+		TransportMaster<IPCRingChannel> ring("ring");
+		TransportMaster<IPCUnixSocket> socket("socket");
+
+		if (ring.start() || socket.start()) {
+			cerr << "Failed to start slaves" << endl;
+			return TestFail;
+		}
+
+		if (testFds(ring) || testInline(ring) || testReserve(ring))
+			return TestFail;
+
+		for (size_t size : { 4096, 32768 }) {
+			if (socket.benchmark(size) || ring.benchmark(size))
+				return TestFail;
+		}
+
+		if (ring.stop() || socket.stop()) {
+			cerr << "Failed to stop slaves" << endl;
+			return TestFail;
+		}
+
+		return TestPass;
+	}
+
+private:
+	vector<uint32_t> received_;
+};
+
+/*
+ * Can't use TEST_REGISTER() as single binary needs to act as both proxy
+ * master and slave.
+ */
+int main(int argc, char **argv)
+{
+	if (argc == 3) {
+		int ipcfd = std::stoi(argv[2]);
+
+		if (!strcmp(argv[1], "ring")) {
+			RingChannelSlave<IPCRingChannel> slave;
+			return slave.run(ipcfd);
+		} else {
+			RingChannelSlave<IPCUnixSocket> slave;
+			return slave.run(ipcfd);
+		}
+	}
+
+	return RingChannelTest().execute();
+}
@@ -0,0 +1,214 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * serializer.cpp - IPC message serialization test
+ */
+
+#include <iostream>
+#include <string.h>
+#include <vector>
+
+#include <libcamera/controls.h>
+
+#include "allocations.h"
+#include "ipc_serializer.h"
+#include "test.h"
+
+using namespace std;
+using namespace libcamera;
+
+static_assert(IPCFixedSize<uint32_t, int32_t, IPCFd>::value == 12,
+	      "Invalid fixed size for fixed-size arguments");
+static_assert(IPCFixedSize<uint32_t, ControlList>::value == 0,
+	      "Invalid fixed size for variable-size arguments");
+
+class SerializerTest : public Test
+{
+protected:
+	int init()
+	{
+		controls_.emplace(AwbEnable, ControlInfo(AwbEnable));
+		controls_.emplace(Brightness, ControlInfo(Brightness, 0, 255));
+		controls_.emplace(ManualExposure, ControlInfo(ManualExposure, 1, 1000000));
+
+		return TestPass;
+	}
+
+	int run()
+	{
+		ControlList list(nullptr);
+		list[&controls_.at(AwbEnable)] = true;
+		list[&controls_.at(Brightness)] = 128;
+		list[&controls_.at(ManualExposure)] = static_cast<int64_t>(1) << 40;
+
+		const uint32_t operation = 3;
+		const unsigned int bufferId = 42;
+		const IPCFd fd{ 7 };
+
+		vector<uint8_t> buffer(4096);
+		vector<int32_t> fds;
+		fds.reserve(4);
+
+		/* Serialize and deserialize in place without allocating memory. */
+		AllocationCounter allocations;
+
+		size_t size = IPCSerializer::size(operation, bufferId, fd, list);
+		IPCSerializer serializer(buffer.data(), size, &fds);
+		if (!serializer.write(operation, bufferId, fd, list)) {
+			cerr << "Serialization failed" << endl;
+			return TestFail;
+		}
+
+		IPCDeserializer deserializer(buffer.data(), size, &fds);
+		uint32_t readOperation = 0;
+		unsigned int readBufferId = 0;
+		IPCFd readFd{ -1 };
+		IPCControlListView view;
+
+		if (!deserializer.read(&readOperation, &readBufferId, &readFd, &view)) {
+			cerr << "Deserialization failed" << endl;
+			return TestFail;
+		}
+
+		int64_t exposure = 0;
+		unsigned int count = 0;
+		for (const auto &ctrl : view) {
+			if (ctrl.id() == ManualExposure)
+				exposure = ctrl.value().getInt64();
+			count++;
+		}
+
+		unsigned int allocated = allocations.count();
+		if (allocated) {
+			cerr << "Serialization allocated " << allocated
+			     << " times" << endl;
+			return TestFail;
+		}
+
+		if (serializer.length() != size || deserializer.remaining()) {
+			cerr << "Invalid serialized size" << endl;
+			return TestFail;
+		}
+
+		if (readOperation != operation || readBufferId != bufferId ||
+		    readFd.fd != fd.fd || fds.size() != 1) {
+			cerr << "Invalid deserialized arguments" << endl;
+			return TestFail;
+		}
+
+		if (count != 3 || exposure != static_cast<int64_t>(1) << 40) {
+			cerr << "Invalid control list view" << endl;
+			return TestFail;
+		}
+
+		/* Deserialize the control list with the control info map. */
+		IPCDeserializer listDeserializer(buffer.data(), size, &fds, &controls_);
+		ControlList readList(nullptr);
+		if (!listDeserializer.read(&readOperation, &readBufferId, &readFd,
+					   &readList)) {
+			cerr << "Control list deserialization failed" << endl;
+			return TestFail;
+		}
+
+		if (readList.size() != 3 ||
+		    !readList[&controls_.at(AwbEnable)].getBool() ||
+		    readList[&controls_.at(Brightness)].getInt() != 128) {
+			cerr << "Invalid deserialized control list" << endl;
+			return TestFail;
+		}
+
+		/* Buffers too small must be rejected. */
+		IPCSerializer small(buffer.data(), size - 1, &fds);
+		if (small.write(operation, bufferId, fd, list)) {
+			cerr << "Serialization overflow not detected" << endl;
+			return TestFail;
+		}
+
+		IPCDeserializer truncated(buffer.data(), size - 1, &fds);
+		if (truncated.read(&readOperation, &readBufferId, &readFd, &view)) {
+			cerr << "Truncated message not detected" << endl;
+			return TestFail;
+		}
+
+		/* Invalid file descriptor indices must be rejected. */
+		vector<int32_t> noFds;
+		IPCDeserializer missingFd(buffer.data(), size, &noFds);
+		if (missingFd.read(&readOperation, &readBufferId, &readFd)) {
+			cerr << "Invalid file descriptor index not detected" << endl;
+			return TestFail;
+		}
+
+		/* Invalid control value types must be rejected. */
+		size_t offset = IPCFixedSize<uint32_t, unsigned int, IPCFd, uint32_t>::value;
+		buffer[offset + sizeof(uint32_t)] = 0xff;
+
+		IPCDeserializer corrupted(buffer.data(), size, &fds);
+		if (corrupted.read(&readOperation, &readBufferId, &readFd, &view)) {
+			cerr << "Invalid control type not detected" << endl;
+			return TestFail;
+		}
+
+		/* Unknown control IDs must be rejected. */
+		fds.clear();
+		IPCSerializer rewrite(buffer.data(), size, &fds);
+		rewrite.write(operation, bufferId, fd, list);
+
+		const uint32_t unknownId = 0xffffffff;
+		memcpy(&buffer[offset], &unknownId, sizeof(unknownId));
+
+		IPCDeserializer unknown(buffer.data(), size, &fds);
+		if (unknown.read(&readOperation, &readBufferId, &readFd, &view)) {
+			cerr << "Invalid control ID not detected" << endl;
+			return TestFail;
+		}
+
+		return testOperationData(list);
+	}
+
+	int testOperationData(const ControlList &list)
+	{
+		IPAOperationData action;
+		action.operation = 2;
+		action.data = { 1, 2, 3 };
+		action.controls.push_back(list);
+
+		vector<uint8_t> buffer(IPCSerializer::size(action));
+		IPCSerializer serializer(buffer.data(), buffer.size());
+		if (!serializer.write(action)) {
+			cerr << "Operation data serialization failed" << endl;
+			return TestFail;
+		}
+
+		/* Control lists are mapped to libcamera's controls by default. */
+		IPAOperationData readAction;
+		IPCDeserializer deserializer(buffer.data(), buffer.size());
+		if (!deserializer.read(&readAction)) {
+			cerr << "Operation data deserialization failed" << endl;
+			return TestFail;
+		}
+
+		if (readAction.operation != action.operation ||
+		    readAction.data != action.data ||
+		    readAction.controls.size() != 1 ||
+		    readAction.controls[0].size() != list.size()) {
+			cerr << "Invalid deserialized operation data" << endl;
+			return TestFail;
+		}
+
+		for (const auto &ctrl : readAction.controls[0]) {
+			if (ctrl.first->id() == Brightness &&
+			    ctrl.second.getInt() != 128) {
+				cerr << "Invalid deserialized control" << endl;
+				return TestFail;
+			}
+		}
+
+		return TestPass;
+	}
+
+private:
+	ControlInfoMap controls_;
+};
+
+TEST_REGISTER(SerializerTest)
@@ -10,9 +10,9 @@
 #include <iostream>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/types.h>
-#include <sys/wait.h>
 #include <unistd.h>
 
 #include <libcamera/camera_manager.h>
@@ -20,6 +20,7 @@
 #include <libcamera/timer.h>
 
 #include "ipc_unixsocket.h"
+#include "slave_process.h"
 #include "test.h"
 #include "utils.h"
 
@@ -197,41 +198,6 @@ private:
 class UnixSocketTest : public Test
 {
 protected:
-	int slaveStart(int fd)
-	{
-		pid_ = fork();
-
-		if (pid_ == -1)
-			return TestFail;
-
-		if (!pid_) {
-			std::string arg = std::to_string(fd);
-			execl("/proc/self/exe", "/proc/self/exe",
-			      arg.c_str(), nullptr);
-
-			/* Only get here if exec fails. */
-			exit(TestFail);
-		}
-
-		return TestPass;
-	}
-
-	int slaveStop()
-	{
-		int status;
-
-		if (pid_ < 0)
-			return TestFail;
-
-		if (waitpid(pid_, &status, 0) < 0)
-			return TestFail;
-
-		if (!WIFEXITED(status) || WEXITSTATUS(status))
-			return TestFail;
-
-		return TestPass;
-	}
-
 	int testReverse()
 	{
 		IPCUnixSocket::Payload message, response;
@@ -349,6 +315,116 @@ protected:
 		return 0;
 	}
 
+	/*
+	 * Send a raw message on the peer socket whose header announces
+	 * \a announced file descriptors, with \a num file descriptors attached.
+	 */
+	int sendRaw(int fd, uint8_t announced, const int *fds, unsigned int num)
+	{
+		/* Mirror the layout of IPCUnixSocket::Header. */
+		struct {
+			uint32_t data;
+			uint8_t fds;
+		} header = { 1, announced };
+		uint8_t data = CMD_REVERSE;
+
+		struct iovec iov[2];
+		iov[0].iov_base = &header;
+		iov[0].iov_len = sizeof(header);
+		iov[1].iov_base = &data;
+		iov[1].iov_len = sizeof(data);
+
+		char buf[CMSG_SPACE(2 * sizeof(int))] = {};
+		struct cmsghdr *cmsg = reinterpret_cast<struct cmsghdr *>(buf);
+		cmsg->cmsg_len = CMSG_LEN(num * sizeof(int));
+		cmsg->cmsg_level = SOL_SOCKET;
+		cmsg->cmsg_type = SCM_RIGHTS;
+		memcpy(CMSG_DATA(cmsg), fds, num * sizeof(int));
+
+		struct msghdr msg = {};
+		msg.msg_iov = iov;
+		msg.msg_iovlen = 2;
+		msg.msg_control = num ? cmsg : nullptr;
+		msg.msg_controllen = num ? cmsg->cmsg_len : 0;
+
+		return sendmsg(fd, &msg, 0) < 0 ? TestFail : TestPass;
+	}
+
+	void mismatchReadyRead(IPCUnixSocket *ipc)
+	{
+		IPCUnixSocket::Payload message;
+		if (!ipc->receive(&message))
+			mismatchReceived_.push_back(message);
+	}
+
+	int testHeaderMismatch()
+	{
+		EventDispatcher *dispatcher = CameraManager::instance()->eventDispatcher();
+		IPCUnixSocket ipc;
+
+		int fd = ipc.create();
+		if (fd < 0)
+			return TestFail;
+
+		ipc.readyRead.connect(this, &UnixSocketTest::mismatchReadyRead);
+		mismatchReceived_.clear();
+
+		int pipefds[2];
+		if (pipe2(pipefds, O_CLOEXEC)) {
+			close(fd);
+			return TestFail;
+		}
+
+		/*
+		 * Announce more, fewer and the same number of file descriptors
+		 * than attached. Only the last message is valid.
+		 */
+		const int fds[2] = { pipefds[1], pipefds[1] };
+		int ret = sendRaw(fd, 2, fds, 1);
+		if (!ret)
+			ret = sendRaw(fd, 0, fds, 1);
+		if (!ret)
+			ret = sendRaw(fd, 1, fds, 2);
+		if (!ret)
+			ret = sendRaw(fd, 1, fds, 1);
+
+		close(pipefds[1]);
+		close(fd);
+
+		if (ret) {
+			close(pipefds[0]);
+			return TestFail;
+		}
+
+		Timer timeout;
+		timeout.start(100);
+		while (timeout.isRunning())
+			dispatcher->processEvents();
+
+		if (mismatchReceived_.size() != 1 ||
+		    mismatchReceived_[0].fds.size() != 1) {
+			cerr << "Invalid messages accepted" << endl;
+			close(pipefds[0]);
+			return TestFail;
+		}
+
+		close(mismatchReceived_[0].fds[0]);
+		mismatchReceived_.clear();
+
+		/*
+		 * All the write ends of the pipe are now closed, including the
+		 * ones received in rejected messages.
+		 */
+		char byte;
+		ret = read(pipefds[0], &byte, 1) == 0 ? TestPass : TestFail;
+		close(pipefds[0]);
+
+		if (ret)
+			cerr << "Rejected file descriptors leaked" << endl;
+
+		return ret;
+	}
+
 	int init()
 	{
 		callResponse_ = nullptr;
@@ -361,7 +437,7 @@ protected:
 		if (slavefd < 0)
 			return TestFail;
 
-		if (slaveStart(slavefd)) {
+		if (slave_.start({ std::to_string(slavefd) })) {
 			cerr << "Failed to start slave" << endl;
 			return TestFail;
 		}
@@ -398,6 +474,12 @@ protected:
 			return TestFail;
 		}
 
+		/* Test that messages with mismatching fds are rejected. */
+		if (testHeaderMismatch()) {
+			cerr << "Header mismatch test failed" << endl;
+			return TestFail;
+		}
+
 		/* Close slave connection. */
 		IPCUnixSocket::Payload close;
 		close.data.push_back(CMD_CLOSE);
@@ -407,7 +489,7 @@ protected:
 		}
 
 		ipc_.close();
-		if (slaveStop()) {
+		if (slave_.wait()) {
 			cerr << "Failed to stop slave" << endl;
 			return TestFail;
 		}
@@ -480,10 +562,11 @@ private:
 		return size;
 	}
 
-	pid_t pid_;
+	SlaveProcess slave_;
 	IPCUnixSocket ipc_;
 	bool callDone_;
 	IPCUnixSocket::Payload *callResponse_;
+	std::vector<IPCUnixSocket::Payload> mismatchReceived_;
 };
 
 /*
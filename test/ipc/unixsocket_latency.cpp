@@ -0,0 +1,201 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * unixsocket_latency.cpp - Unix socket IPC round-trip latency test
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <stdlib.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <vector>
+
+#include <libcamera/camera_manager.h>
+#include <libcamera/event_dispatcher.h>
+#include <libcamera/timer.h>
+
+#include "ipc_unixsocket.h"
+#include "slave_process.h"
+#include "test.h"
+
+#define CMD_CLOSE	0
+#define CMD_ECHO	1
+
+using namespace std;
+using namespace libcamera;
+
+class UnixSocketLatencySlave
+{
+public:
+	UnixSocketLatencySlave()
+		: exitCode_(EXIT_FAILURE), exit_(false)
+	{
+		dispatcher_ = CameraManager::instance()->eventDispatcher();
+		ipc_.readyRead.connect(this, &UnixSocketLatencySlave::readyRead);
+	}
+
+	int run(int fd)
+	{
+		if (ipc_.bind(fd)) {
+			cerr << "Failed to connect to IPC channel" << endl;
+			return EXIT_FAILURE;
+		}
+
+		while (!exit_)
+			dispatcher_->processEvents();
+
+		ipc_.close();
+
+		return exitCode_;
+	}
+
+private:
+	void readyRead(IPCUnixSocket *ipc)
+	{
+		if (ipc->receive(&message_)) {
+			cerr << "Receive message failed" << endl;
+			stop(EXIT_FAILURE);
+			return;
+		}
+
+		if (message_.data.empty() || message_.data[0] == CMD_CLOSE) {
+			stop(EXIT_SUCCESS);
+			return;
+		}
+
+		/* Echo the message back. */
+		if (ipc_.send(message_)) {
+			cerr << "Echo failed" << endl;
+			stop(EXIT_FAILURE);
+		}
+	}
+
+	void stop(int code)
+	{
+		exitCode_ = code;
+		exit_ = true;
+	}
+
+	IPCUnixSocket ipc_;
+	IPCUnixSocket::Payload message_;
+	EventDispatcher *dispatcher_;
+	int exitCode_;
+	bool exit_;
+};
+
+class UnixSocketLatencyTest : public Test
+{
+protected:
+	static constexpr unsigned int NumMessages = 10000;
+	static constexpr unsigned int MessageSize = 256;
+
+	int run()
+	{
+		EventDispatcher *dispatcher = CameraManager::instance()->eventDispatcher();
+
+		int slavefd = ipc_.create();
+		if (slavefd < 0)
+			return TestFail;
+
+		if (slave_.start({ std::to_string(slavefd) })) {
+			cerr << "Failed to start slave" << endl;
+			return TestFail;
+		}
+
+		ipc_.readyRead.connect(this, &UnixSocketLatencyTest::readyRead);
+
+		IPCUnixSocket::Payload message;
+		message.data.resize(MessageSize);
+		message.data[0] = CMD_ECHO;
+
+		vector<chrono::nanoseconds> latencies;
+		latencies.reserve(NumMessages);
+
+		Timer timeout;
+		timeout.start(10000);
+
+		for (unsigned int i = 0; i < NumMessages; ++i) {
+			message.data[1] = i;
+			received_ = false;
+
+			auto start = chrono::steady_clock::now();
+
+			if (ipc_.send(message)) {
+				cerr << "Failed to send message" << endl;
+				return TestFail;
+			}
+
+			while (!received_ && timeout.isRunning())
+				dispatcher->processEvents();
+
+			if (!received_) {
+				cerr << "Timeout after " << i << " messages" << endl;
+				return TestFail;
+			}
+
+			latencies.push_back(chrono::steady_clock::now() - start);
+
+			if (response_.data != message.data) {
+				cerr << "Invalid response" << endl;
+				return TestFail;
+			}
+		}
+
+		IPCUnixSocket::Payload close;
+		close.data.push_back(CMD_CLOSE);
+		if (ipc_.send(close)) {
+			cerr << "Closing IPC channel failed" << endl;
+			return TestFail;
+		}
+
+		ipc_.close();
+		if (slave_.wait()) {
+			cerr << "Failed to stop slave" << endl;
+			return TestFail;
+		}
+
+		sort(latencies.begin(), latencies.end());
+
+		cout << "Round-trip latency for " << MessageSize
+		     << " bytes messages: median "
+		     << latencies[latencies.size() / 2].count() << " ns, p99 "
+		     << latencies[latencies.size() * 99 / 100].count() << " ns"
+		     << endl;
+
+		return TestPass;
+	}
+
+private:
+	void readyRead(IPCUnixSocket *ipc)
+	{
+		if (ipc->receive(&response_)) {
+			cerr << "Receive message failed" << endl;
+			return;
+		}
+
+		received_ = true;
+	}
+
+	SlaveProcess slave_;
+	IPCUnixSocket ipc_;
+	IPCUnixSocket::Payload response_;
+	bool received_;
+};
+
+/*
+ * Can't use TEST_REGISTER() as single binary needs to act as both proxy
+ * master and slave.
+ */
+int main(int argc, char **argv)
+{
+	if (argc == 2) {
+		int ipcfd = std::stoi(argv[1]);
+		UnixSocketLatencySlave slave;
+		return slave.run(ipcfd);
+	}
+
+	return UnixSocketLatencyTest().execute();
+}
@@ -0,0 +1,84 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * latency-histogram.cpp - Latency histogram test
+ */
+
+#include <iostream>
+
+#include "latency_histogram.h"
+#include "test.h"
+
+using namespace std;
+using namespace libcamera;
+
+class LatencyHistogramTest : public Test
+{
+protected:
+	/* Check that a percentile is within the histogram precision. */
+	bool checkPercentile(const char *name, uint64_t value, uint64_t expected)
+	{
+		if (value >= expected && value <= expected + expected / 8)
+			return true;
+
+		cout << name << " is " << value << ", expected " << expected
+		     << endl;
+		return false;
+	}
+
+	int run()
+	{
+		LatencyHistogram histogram;
+		LatencyStatistics stats = histogram.statistics();
+
+		if (stats.count || stats.p50 || stats.p99 || stats.max) {
+			cout << "Empty histogram has non-zero statistics" << endl;
+			return TestFail;
+		}
+
+		/* Record latencies from 1µs to 1ms in 1µs steps. */
+		for (uint64_t i = 1; i <= 1000; ++i)
+			histogram.record(i * 1000);
+
+		stats = histogram.statistics();
+
+		if (stats.count != 1000 || stats.max != 1000000) {
+			cout << "Invalid count " << stats.count << " or max "
+			     << stats.max << endl;
+			return TestFail;
+		}
+
+		if (!checkPercentile("p50", stats.p50, 500000) ||
+		    !checkPercentile("p99", stats.p99, 990000))
+			return TestFail;
+
+		/* Small latencies are recorded exactly. */
+		histogram.reset();
+		for (uint64_t i = 0; i < 8; ++i)
+			histogram.record(i);
+
+		stats = histogram.statistics();
+		if (stats.p50 != 3 || stats.p99 != 7) {
+			cout << "Invalid small latencies percentiles" << endl;
+			return TestFail;
+		}
+
+		/* Outliers affect the maximum but not the median. */
+		histogram.reset();
+		for (unsigned int i = 0; i < 99; ++i)
+			histogram.record(1000);
+		histogram.record(UINT64_MAX);
+
+		stats = histogram.statistics();
+		if (!checkPercentile("p50", stats.p50, 1000) ||
+		    stats.max != UINT64_MAX) {
+			cout << "Invalid outlier handling" << endl;
+			return TestFail;
+		}
+
+		return TestPass;
+	}
+};
+
+TEST_REGISTER(LatencyHistogramTest)
@@ -0,0 +1,50 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * allocations.cpp - Memory allocation counting for tests
+ */
+
+#include <atomic>
+#include <new>
+#include <stdlib.h>
+
+#include "allocations.h"
+
+/*
+ * The replacement operators live in their own translation unit, to prevent the
+ * compiler from matching the malloc() and free() calls against the new and
+ * delete expressions of the callers.
+ */
+static std::atomic<unsigned int> allocations(0);
+
+void *operator new(size_t size)
+{
+	allocations.fetch_add(1, std::memory_order_relaxed);
+
+	void *mem = malloc(size ? size : 1);
+	if (!mem)
+		throw std::bad_alloc();
+
+	return mem;
+}
+
+void operator delete(void *mem) noexcept
+{
+	free(mem);
+}
+
+void operator delete(void *mem, size_t) noexcept
+{
+	free(mem);
+}
+
+AllocationCounter::AllocationCounter()
+	: start_(allocations.load(std::memory_order_relaxed))
+{
+}
+
+unsigned int AllocationCounter::count() const
+{
+	return allocations.load(std::memory_order_relaxed) - start_;
+}
@@ -0,0 +1,26 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * allocations.h - Memory allocation counting for tests
+ */
+#ifndef __TEST_ALLOCATIONS_H__
+#define __TEST_ALLOCATIONS_H__
+
+/*
+ * The global operator new is replaced by libtest to count memory allocations.
+ * An AllocationCounter reports the number of allocations performed by all
+ * threads since it has been constructed.
+ */
+class AllocationCounter
+{
+public:
+	AllocationCounter();
+
+	unsigned int count() const;
+
+private:
+	unsigned int start_;
+};
+
+#endif /* __TEST_ALLOCATIONS_H__ */
@@ -0,0 +1,70 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * slave_process.cpp - Slave process for multi-process tests
+ */
+
+#include <signal.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "slave_process.h"
+#include "test.h"
+
+SlaveProcess::SlaveProcess()
+	: pid_(-1)
+{
+}
+
+SlaveProcess::~SlaveProcess()
+{
+	/* Don't leave a slave behind when the test fails early. */
+	if (pid_ > 0) {
+		kill(pid_, SIGKILL);
+		waitpid(pid_, nullptr, 0);
+	}
+}
+
+int SlaveProcess::start(const std::vector<std::string> &args)
+{
+	/* Prepare the arguments before forking, the child must not allocate. */
+	std::vector<char *> argv;
+	argv.push_back(const_cast<char *>("/proc/self/exe"));
+	for (const std::string &arg : args)
+		argv.push_back(const_cast<char *>(arg.c_str()));
+	argv.push_back(nullptr);
+
+	pid_ = fork();
+	if (pid_ == -1)
+		return TestFail;
+
+	if (!pid_) {
+		execv(argv[0], argv.data());
+
+		/* Only get here if exec fails. */
+		_exit(EXIT_FAILURE);
+	}
+
+	return TestPass;
+}
+
+int SlaveProcess::wait()
+{
+	int status;
+
+	if (pid_ < 0)
+		return TestFail;
+
+	pid_t pid = pid_;
+	pid_ = -1;
+
+	if (waitpid(pid, &status, 0) < 0)
+		return TestFail;
+
+	if (!WIFEXITED(status) || WEXITSTATUS(status))
+		return TestFail;
+
+	return TestPass;
+}
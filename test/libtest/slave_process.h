@@ -0,0 +1,32 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * slave_process.h - Slave process for multi-process tests
+ */
+#ifndef __TEST_SLAVE_PROCESS_H__
+#define __TEST_SLAVE_PROCESS_H__
+
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+/*
+ * Tests that need a peer process re-execute their own binary with arguments
+ * that select the slave role in main(). A SlaveProcess starts the slave and
+ * reaps it, reporting a failure if it doesn't exit successfully.
+ */
+class SlaveProcess
+{
+public:
+	SlaveProcess();
+	~SlaveProcess();
+
+	int start(const std::vector<std::string> &args);
+	int wait();
+
+private:
+	pid_t pid_;
+};
+
+#endif /* __TEST_SLAVE_PROCESS_H__ */
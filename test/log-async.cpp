@@ -0,0 +1,154 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * log-async.cpp - Asynchronous log output test
+ */
+
+#include <fstream>
+#include <iostream>
+#include <stdlib.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include <libcamera/logging.h>
+
+#include "log.h"
+#include "test.h"
+
+using namespace std;
+using namespace libcamera;
+
+LOG_DEFINE_CATEGORY(LogAsyncTest)
+
+class LogAsyncTest : public Test
+{
+protected:
+	static constexpr unsigned int NumThreads = 4;
+	/* Small enough for all messages to fit in the log ring buffer. */
+	static constexpr unsigned int NumMessagesLight = 500;
+	/* Large enough to saturate the log ring buffer. */
+	static constexpr unsigned int NumMessagesHeavy = 10000;
+
+	enum Load {
+		Light,
+		Heavy,
+	};
+
+	int init() override
+	{
+		/*
+		 * The log file must be set before the logger is created, which
+		 * happens before main() is called. It is thus set in the
+		 * environment by the test runner.
+		 */
+		const char *path = getenv("LIBCAMERA_LOG_FILE");
+		if (!path) {
+			cerr << "LIBCAMERA_LOG_FILE not set" << endl;
+			return TestSkip;
+		}
+
+		path_ = path;
+
+		return TestPass;
+	}
+
+	void logMessages(Load load, unsigned int count)
+	{
+		vector<thread> threads;
+
+		for (unsigned int i = 0; i < NumThreads; ++i)
+			threads.emplace_back([load, count, i]() {
+				for (unsigned int j = 0; j < count; ++j)
+					LOG(LogAsyncTest, Info)
+						<< "load " << load << " thread " << i
+						<< " message " << j;
+			});
+
+		for (thread &t : threads)
+			t.join();
+	}
+
+	int run() override
+	{
+		/*
+		 * Messages may only be dropped when the ring buffer is full, so
+		 * they must all be written under a light load.
+		 */
+		logMessages(Light, NumMessagesLight);
+		logMessages(Heavy, NumMessagesHeavy);
+
+		/* Switching to stderr writes all pending messages. */
+		logSetFile(nullptr);
+
+		ifstream file(path_);
+		if (!file.good()) {
+			cerr << "Failed to open tmp log file" << endl;
+			return TestFail;
+		}
+
+		vector<int> last[2] = {
+			vector<int>(NumThreads, -1),
+			vector<int>(NumThreads, -1),
+		};
+		unsigned int messages[2] = { 0, 0 };
+		unsigned int dropped = 0;
+		string line;
+
+		while (getline(file, line)) {
+			if (line.find(" log messages dropped]") != string::npos) {
+				dropped += stoul(line.substr(1));
+				continue;
+			}
+
+			size_t pos = line.find("load ");
+			unsigned int load;
+			unsigned int thread;
+			int index;
+			if (pos == string::npos ||
+			    sscanf(line.c_str() + pos, "load %u thread %u message %d",
+				   &load, &thread, &index) != 3 ||
+			    load > Heavy || thread >= NumThreads) {
+				cerr << "Invalid log line: " << line << endl;
+				return TestFail;
+			}
+
+			/* Messages from a thread shall be output in order. */
+			if (index <= last[load][thread]) {
+				cerr << "Message out of order: " << line << endl;
+				return TestFail;
+			}
+
+			last[load][thread] = index;
+			messages[load]++;
+		}
+
+		if (messages[Light] != NumThreads * NumMessagesLight) {
+			cerr << "Dropped "
+			     << NumThreads * NumMessagesLight - messages[Light]
+			     << " messages under light load" << endl;
+			return TestFail;
+		}
+
+		if (messages[Heavy] + dropped != NumThreads * NumMessagesHeavy) {
+			cerr << "Lost "
+			     << NumThreads * NumMessagesHeavy - messages[Heavy] - dropped
+			     << " messages" << endl;
+			return TestFail;
+		}
+
+		return TestPass;
+	}
+
+	void cleanup() override
+	{
+		unlink(path_.c_str());
+	}
+
+private:
+	string path_;
+};
+
+TEST_REGISTER(LogAsyncTest)
@@ -0,0 +1,168 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * log-binary.cpp - Binary log format test
+ */
+
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include <libcamera/logging.h>
+
+#include "log.h"
+#include "log_format.h"
+#include "test.h"
+
+using namespace std;
+using namespace libcamera;
+
+LOG_DEFINE_CATEGORY(LogBinaryTest)
+LOG_DEFINE_CATEGORY(LogBinaryTestOther)
+
+class LogBinaryTest : public Test
+{
+protected:
+	int init() override
+	{
+		/*
+		 * The log file and format must be set before the logger is
+		 * created, which happens before main() is called. They are
+		 * thus set in the environment by the test runner.
+		 */
+		const char *path = getenv("LIBCAMERA_LOG_FILE");
+		const char *format = getenv("LIBCAMERA_LOG_FORMAT");
+		if (!path || !format || strcmp(format, "binary")) {
+			cerr << "Binary log file not set" << endl;
+			return TestSkip;
+		}
+
+		path_ = path;
+
+		return TestPass;
+	}
+
+	int run() override
+	{
+		const vector<string> expected = {
+			"message 0", "other 0", "message 1", "other 1",
+			"message 2", "other 2",
+		};
+
+		for (unsigned int i = 0; i < 3; ++i) {
+			LOG(LogBinaryTest, Info) << "message " << i;
+			LOG(LogBinaryTestOther, Warning) << "other " << i;
+			LOG(LogBinaryTestOther, Debug) << "discarded " << i;
+		}
+
+		/* Switching to stderr writes all pending messages. */
+		logSetFile(nullptr);
+
+		ifstream file(path_, ios::binary);
+		string data((istreambuf_iterator<char>(file)),
+			    istreambuf_iterator<char>());
+
+		LogFileHeader header;
+		if (data.size() < sizeof(header)) {
+			cerr << "Log file too short" << endl;
+			return TestFail;
+		}
+
+		memcpy(&header, data.data(), sizeof(header));
+		if (memcmp(header.magic, LOG_FILE_MAGIC, sizeof(header.magic)) ||
+		    header.version != LOG_FILE_VERSION) {
+			cerr << "Invalid log file header" << endl;
+			return TestFail;
+		}
+
+		map<unsigned int, string> categories;
+		map<unsigned int, unsigned int> locations;
+		vector<string> messages;
+		size_t offset = sizeof(header);
+
+		while (offset < data.size()) {
+			const char *record = data.data() + offset;
+
+			switch (record[0]) {
+			case LogRecordCategory: {
+				LogCategoryRecord def;
+				memcpy(&def, record, sizeof(def));
+				categories[def.id] = string(record + sizeof(def), def.length);
+				offset += sizeof(def) + def.length;
+				break;
+			}
+
+			case LogRecordLocation: {
+				LogLocationRecord def;
+				memcpy(&def, record, sizeof(def));
+				locations[def.id] = def.line;
+				offset += sizeof(def) + def.length;
+				break;
+			}
+
+			case LogRecordMessage: {
+				LogMessageRecord msg;
+				memcpy(&msg, record, sizeof(msg));
+
+				/* Definitions shall precede their first use. */
+				if (!categories.count(msg.category) ||
+				    !locations.count(msg.location)) {
+					cerr << "Undefined category or location" << endl;
+					return TestFail;
+				}
+
+				string text(record + sizeof(msg), msg.length);
+				const string &category = categories[msg.category];
+				if ((text.find("message") == 0 && category != "LogBinaryTest") ||
+				    (text.find("other") == 0 && category != "LogBinaryTestOther")) {
+					cerr << "Invalid category " << category << endl;
+					return TestFail;
+				}
+
+				messages.push_back(text);
+				offset += sizeof(msg) + msg.length;
+				break;
+			}
+
+			default:
+				cerr << "Unexpected record type "
+				     << static_cast<unsigned int>(record[0]) << endl;
+				return TestFail;
+			}
+		}
+
+		if (offset != data.size()) {
+			cerr << "Truncated log file" << endl;
+			return TestFail;
+		}
+
+		if (messages != expected) {
+			cerr << "Unexpected log messages" << endl;
+			return TestFail;
+		}
+
+		/* Each category and location shall be defined once. */
+		if (categories.size() != 2 || locations.size() != 2) {
+			cerr << "Invalid number of definitions" << endl;
+			return TestFail;
+		}
+
+		return TestPass;
+	}
+
+	void cleanup() override
+	{
+		unlink(path_.c_str());
+	}
+
+private:
+	string path_;
+};
+
+TEST_REGISTER(LogBinaryTest)
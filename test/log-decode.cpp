@@ -0,0 +1,154 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * log-decode.cpp - Binary log decoder test
+ */
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include <libcamera/logging.h>
+
+#include "log.h"
+#include "test.h"
+
+using namespace std;
+using namespace libcamera;
+
+LOG_DEFINE_CATEGORY(LogDecodeTest)
+LOG_DEFINE_CATEGORY(LogDecodeTestOther)
+
+class LogDecodeTest : public Test
+{
+protected:
+	int init() override
+	{
+		/*
+		 * The binary log file must be set before the logger is created,
+		 * which happens before main() is called. It is thus set in the
+		 * environment by the test runner, along with the path to the
+		 * decoder.
+		 */
+		const char *path = getenv("LIBCAMERA_LOG_FILE");
+		const char *format = getenv("LIBCAMERA_LOG_FORMAT");
+		const char *decoder = getenv("LOG_DECODE");
+		if (!path || !format || strcmp(format, "binary") || !decoder) {
+			cerr << "Binary log file or decoder not set" << endl;
+			return TestSkip;
+		}
+
+		binaryPath_ = path;
+		textPath_ = binaryPath_ + ".txt";
+		decoder_ = decoder;
+
+		return TestPass;
+	}
+
+	void logMessages()
+	{
+		for (unsigned int i = 0; i < 3; ++i) {
+			LOG(LogDecodeTest, Info) << "message " << i;
+			LOG(LogDecodeTestOther, Warning) << "other " << i;
+			LOG(LogDecodeTestOther, Error) << "error with spaces  " << i;
+		}
+	}
+
+	/*
+	 * Split log lines in timestamps and contents, as the timestamps differ
+	 * between the binary and text logs.
+	 */
+	int parse(istream &input, vector<string> *lines)
+	{
+		string line;
+
+		while (getline(input, line)) {
+			unsigned int hours, minutes, seconds, nsecs;
+			size_t pos = line.find("] ");
+
+			if (pos == string::npos ||
+			    sscanf(line.c_str(), "[%u:%2u:%2u.%9u] ", &hours,
+				   &minutes, &seconds, &nsecs) != 4) {
+				cerr << "Invalid timestamp: " << line << endl;
+				return TestFail;
+			}
+
+			lines->push_back(line.substr(pos + 2));
+		}
+
+		return TestPass;
+	}
+
+	int run() override
+	{
+		logMessages();
+
+		/* Switching to a text log file writes all pending messages. */
+		logSetFile(textPath_.c_str());
+
+		logMessages();
+
+		logSetFile(nullptr);
+
+		string command = decoder_ + " " + binaryPath_;
+		FILE *pipe = popen(command.c_str(), "r");
+		if (!pipe) {
+			cerr << "Failed to run the decoder" << endl;
+			return TestFail;
+		}
+
+		string decoded;
+		char buffer[256];
+		size_t size;
+		while ((size = fread(buffer, 1, sizeof(buffer), pipe)) > 0)
+			decoded.append(buffer, size);
+
+		if (pclose(pipe)) {
+			cerr << "Decoder failed" << endl;
+			return TestFail;
+		}
+
+		istringstream decodedStream(decoded);
+		ifstream textStream(textPath_);
+
+		vector<string> decodedLines;
+		vector<string> textLines;
+		if (parse(decodedStream, &decodedLines) ||
+		    parse(textStream, &textLines))
+			return TestFail;
+
+		if (decodedLines.size() != 9) {
+			cerr << "Decoded " << decodedLines.size()
+			     << " lines, expected 9" << endl;
+			return TestFail;
+		}
+
+		if (decodedLines != textLines) {
+			cerr << "Decoded binary log doesn't match the text log"
+			     << endl;
+			return TestFail;
+		}
+
+		return TestPass;
+	}
+
+	void cleanup() override
+	{
+		unlink(binaryPath_.c_str());
+		unlink(textPath_.c_str());
+	}
+
+private:
+	string binaryPath_;
+	string textPath_;
+	string decoder_;
+};
+
+TEST_REGISTER(LogDecodeTest)
@@ -0,0 +1,86 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * log-overhead.cpp - Disabled log statements overhead test
+ */
+
+#include <chrono>
+#include <iostream>
+
+#include <libcamera/logging.h>
+
+#include "log.h"
+#include "test.h"
+
+using namespace std;
+using namespace libcamera;
+
+LOG_DEFINE_CATEGORY(LogOverheadTest)
+
+namespace {
+
+unsigned int evaluations = 0;
+
+unsigned int evaluate(unsigned int value)
+{
+	evaluations++;
+	return value;
+}
+
+} /* namespace */
+
+class LogOverheadTest : public Test
+{
+protected:
+	static constexpr unsigned int NumFrames = 1000000;
+
+	/*
+	 * Emulate the per-frame work of the buffer queue and dequeue paths,
+	 * with and without their debug log statements.
+	 */
+	template<bool logging>
+	chrono::duration<double, nano> frames()
+	{
+		volatile unsigned int sink = 0;
+
+		auto start = chrono::steady_clock::now();
+
+		for (unsigned int i = 0; i < NumFrames; ++i) {
+			sink = sink + i;
+			if (logging)
+				LOG(LogOverheadTest, Debug)
+					<< "Queueing buffer " << evaluate(i);
+
+			sink = sink + i;
+			if (logging)
+				LOG(LogOverheadTest, Debug)
+					<< "Buffer " << evaluate(i) << " is available";
+		}
+
+		return chrono::steady_clock::now() - start;
+	}
+
+	int run() override
+	{
+		logSetLevel("LogOverheadTest", "INFO");
+
+		chrono::duration<double, nano> disabled = frames<true>();
+		chrono::duration<double, nano> none = frames<false>();
+
+		if (evaluations) {
+			cout << "Disabled log statements evaluated "
+			     << evaluations << " arguments" << endl;
+			return TestFail;
+		}
+
+		cout << "Per-frame time with debug disabled: "
+		     << disabled.count() / NumFrames << " ns" << endl;
+		cout << "Per-frame time without logging: "
+		     << none.count() / NumFrames << " ns" << endl;
+
+		return TestPass;
+	}
+};
+
+TEST_REGISTER(LogOverheadTest)
@@ -0,0 +1,117 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * message-throughput.cpp - Cross-thread message throughput test
+ */
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "message.h"
+#include "thread.h"
+#include "test.h"
+#include "utils.h"
+
+using namespace std;
+using namespace libcamera;
+
+class CountingReceiver : public Object
+{
+public:
+	CountingReceiver()
+		: count_(0), invalidThread_(false)
+	{
+	}
+
+	unsigned int count() const { return count_.load(memory_order_acquire); }
+	bool invalidThread() const { return invalidThread_; }
+	void reset() { count_.store(0, memory_order_release); }
+
+protected:
+	void message(Message *msg)
+	{
+		if (thread() != Thread::current())
+			invalidThread_ = true;
+
+		count_.fetch_add(1, memory_order_release);
+	}
+
+private:
+	atomic<unsigned int> count_;
+	bool invalidThread_;
+};
+
+class MessageThroughputTest : public Test
+{
+protected:
+	int run()
+	{
+		static const unsigned int producerCounts[] = { 1, 2, 4, 8, 16 };
+		const unsigned int totalMessages = 160000;
+
+		CountingReceiver receiver;
+		receiver.moveToThread(&thread_);
+
+		thread_.start();
+
+		for (unsigned int producers : producerCounts) {
+			unsigned int messages = totalMessages / producers;
+			vector<thread> threads;
+
+			receiver.reset();
+
+			auto start = chrono::steady_clock::now();
+
+			for (unsigned int i = 0; i < producers; ++i) {
+				threads.emplace_back([&receiver, messages]() {
+					for (unsigned int j = 0; j < messages; ++j)
+						receiver.postMessage(utils::make_unique<Message>(Message::None));
+				});
+			}
+
+			for (thread &t : threads)
+				t.join();
+
+			auto timeout = start + chrono::seconds(10);
+			while (receiver.count() < totalMessages) {
+				if (chrono::steady_clock::now() > timeout) {
+					cout << "Only " << receiver.count() << " of "
+					     << totalMessages << " messages received with "
+					     << producers << " producers" << endl;
+					return TestFail;
+				}
+
+				this_thread::sleep_for(chrono::microseconds(100));
+			}
+
+			chrono::duration<double> duration =
+				chrono::steady_clock::now() - start;
+
+			cout << producers << " producer(s): "
+			     << static_cast<unsigned int>(totalMessages / duration.count())
+			     << " messages/s" << endl;
+		}
+
+		if (receiver.invalidThread()) {
+			cout << "Message received in incorrect thread" << endl;
+			return TestFail;
+		}
+
+		return TestPass;
+	}
+
+	void cleanup()
+	{
+		thread_.exit(0);
+		thread_.wait();
+	}
+
+private:
+	Thread thread_;
+};
+
+TEST_REGISTER(MessageThroughputTest)
@@ -5,7 +5,10 @@
  * process_test.cpp - Process test
  */
 
+#include <errno.h>
 #include <iostream>
+#include <sys/types.h>
+#include <sys/wait.h>
 #include <unistd.h>
 #include <vector>
 
@@ -69,6 +72,23 @@ protected:
 			return TestFail;
 		}
 
+		/* Destroying a running process shall not leave a zombie. */
+		Process *proc = new Process();
+		ret = proc->start("/proc/self/exe", args);
+		if (ret) {
+			cerr << "failed to start process" << endl;
+			delete proc;
+			return TestFail;
+		}
+
+		delete proc;
+
+		int status;
+		if (waitpid(-1, &status, WNOHANG) != -1 || errno != ECHILD) {
+			cerr << "destroyed process not reaped" << endl;
+			return TestFail;
+		}
+
 		return TestPass;
 	}
 
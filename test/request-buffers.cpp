@@ -0,0 +1,130 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * request-buffers.cpp - Request buffers handling test and benchmark
+ */
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+
+#include <libcamera/buffer.h>
+#include <libcamera/request.h>
+#include <libcamera/stream.h>
+
+#include "test.h"
+
+using namespace std;
+using namespace libcamera;
+
+class TestStream : public Stream
+{
+public:
+	TestStream()
+	{
+		memoryType_ = InternalMemory;
+		bufferPool_.createBuffers(1);
+	}
+};
+
+class RequestBuffersTest : public Test
+{
+protected:
+	int run()
+	{
+		const unsigned int numStreams = 2;
+		const unsigned int iterations = 1000000;
+		TestStream streams[Request::MaxBuffers + 1];
+
+		/* Test that buffers can be added and looked up. */
+		Request request(nullptr);
+
+		for (unsigned int i = 0; i < Request::MaxBuffers; ++i) {
+			if (request.addBuffer(streams[i].createBuffer(0))) {
+				cout << "Failed to add buffer to request" << endl;
+				return TestFail;
+			}
+		}
+
+		if (request.addBuffer(streams[0].createBuffer(0)) != -EEXIST) {
+			cout << "Duplicated stream not rejected" << endl;
+			return TestFail;
+		}
+
+		if (request.addBuffer(streams[Request::MaxBuffers].createBuffer(0)) != -ENOSPC) {
+			cout << "Request overflow not rejected" << endl;
+			return TestFail;
+		}
+
+		if (request.buffers().size() != Request::MaxBuffers) {
+			cout << "Invalid number of buffers in request" << endl;
+			return TestFail;
+		}
+
+		unsigned int index = 0;
+		for (auto const &it : request.buffers()) {
+			if (it.first != &streams[index] ||
+			    request.findBuffer(it.first) != it.second) {
+				cout << "Invalid buffer for stream " << index << endl;
+				return TestFail;
+			}
+
+			index++;
+		}
+
+		if (request.findBuffer(&streams[Request::MaxBuffers])) {
+			cout << "Buffer found for stream not in request" << endl;
+			return TestFail;
+		}
+
+		/*
+		 * Measure the cost of the buffer lookups performed for every
+		 * frame by the camera and pipeline handlers when queuing and
+		 * completing a request with one buffer per stream.
+		 */
+		Request frame(nullptr);
+		for (unsigned int i = 0; i < numStreams; ++i)
+			frame.addBuffer(streams[i].createBuffer(0));
+
+		unsigned int found = 0;
+
+		auto start = chrono::steady_clock::now();
+
+		for (unsigned int i = 0; i < iterations; ++i) {
+			for (auto const &it : frame.buffers())
+				found += frame.findBuffer(it.first) == it.second;
+		}
+
+		auto duration = chrono::steady_clock::now() - start;
+
+		if (found != iterations * numStreams) {
+			cout << "Buffer lookup failed" << endl;
+			return TestFail;
+		}
+
+		cout << "Lookup: "
+		     << chrono::duration_cast<chrono::nanoseconds>(duration).count() / iterations
+		     << " ns per request" << endl;
+
+		/* Measure the cost of building and destroying a request. */
+		start = chrono::steady_clock::now();
+
+		for (unsigned int i = 0; i < iterations / 10; ++i) {
+			Request *req = new Request(nullptr);
+			for (unsigned int j = 0; j < numStreams; ++j)
+				req->addBuffer(streams[j].createBuffer(0));
+			delete req;
+		}
+
+		duration = chrono::steady_clock::now() - start;
+
+		cout << "Build: "
+		     << chrono::duration_cast<chrono::nanoseconds>(duration).count() / (iterations / 10)
+		     << " ns per request" << endl;
+
+		return TestPass;
+	}
+};
+
+TEST_REGISTER(RequestBuffersTest)
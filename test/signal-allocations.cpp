@@ -0,0 +1,113 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * signal-allocations.cpp - Cross-thread signal delivery memory allocation test
+ */
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include <libcamera/signal.h>
+
+#include "allocations.h"
+#include "test.h"
+#include "thread.h"
+
+using namespace std;
+using namespace libcamera;
+
+class SignalReceiver : public Object
+{
+public:
+	SignalReceiver()
+		: count_(0)
+	{
+	}
+
+	unsigned int count() const { return count_.load(memory_order_acquire); }
+
+	void slot(int value, unsigned int sequence)
+	{
+		count_.fetch_add(1, memory_order_release);
+	}
+
+private:
+	atomic<unsigned int> count_;
+};
+
+class SignalAllocationsTest : public Test
+{
+protected:
+	bool waitForSignals(unsigned int count)
+	{
+		for (unsigned int i = 0; i < 1000; ++i) {
+			if (receiver_.count() >= count)
+				return true;
+
+			this_thread::sleep_for(chrono::milliseconds(1));
+		}
+
+		return false;
+	}
+
+	int run()
+	{
+		const unsigned int emissions = 256;
+
+		signal_.connect(&receiver_, &SignalReceiver::slot);
+		receiver_.moveToThread(&thread_);
+
+		/*
+		 * Queue signals before starting the thread to populate the
+		 * message pools with enough memory for all the emissions of
+		 * the measurement below.
+		 */
+		for (unsigned int i = 0; i < emissions; ++i)
+			signal_.emit(42, i);
+
+		thread_.start();
+
+		if (!waitForSignals(emissions)) {
+			cout << "Failed to receive warm-up signals" << endl;
+			return TestFail;
+		}
+
+		/* Measure allocations for steady-state signal delivery. */
+		AllocationCounter allocations;
+
+		for (unsigned int i = 0; i < emissions; ++i)
+			signal_.emit(42, i);
+
+		if (!waitForSignals(emissions * 2)) {
+			cout << "Failed to receive signals" << endl;
+			return TestFail;
+		}
+
+		unsigned int count = allocations.count();
+
+		if (count) {
+			cout << count << " allocations for "
+			     << emissions << " cross-thread signal deliveries"
+			     << endl;
+			return TestFail;
+		}
+
+		return TestPass;
+	}
+
+	void cleanup()
+	{
+		thread_.exit(0);
+		thread_.wait();
+	}
+
+private:
+	Signal<int, unsigned int> signal_;
+	SignalReceiver receiver_;
+	Thread thread_;
+};
+
+TEST_REGISTER(SignalAllocationsTest)
@@ -69,6 +69,24 @@ protected:
 		signalVoid_.disconnect(this, &SignalTest::slotDisconnect);
 	}
 
+	void slotDisconnectOther()
+	{
+		called_ = true;
+		signalVoid_.disconnect(this, &SignalTest::slotVoid);
+	}
+
+	void slotConnect()
+	{
+		signalVoid_.connect(this, &SignalTest::slotVoid);
+	}
+
+	void slotDelete()
+	{
+		called_ = true;
+		delete dynamicSignal_;
+		dynamicSignal_ = nullptr;
+	}
+
 	void slotInteger1(int value)
 	{
 		values_[0] = value;
@@ -174,6 +192,45 @@ protected:
 			return TestFail;
 		}
 
+		/* Test disconnection of a later slot from a slot. */
+		signalVoid_.disconnect();
+		signalVoid_.connect(this, &SignalTest::slotDisconnectOther);
+		signalVoid_.connect(this, &SignalTest::slotVoid);
+		signalVoid_.connect(this, &SignalTest::slotVoid);
+
+		called_ = false;
+		signalVoid_.emit();
+		if (!called_) {
+			cout << "Signal emission with disconnection from slot test failed" << endl;
+			return TestFail;
+		}
+
+		signalVoid_.disconnect(this, &SignalTest::slotDisconnectOther);
+		called_ = false;
+		signalVoid_.emit();
+		if (called_) {
+			cout << "Signal disconnection of other slot from slot test failed" << endl;
+			return TestFail;
+		}
+
+		/* Test that slots connected from a slot are called next time. */
+		signalVoid_.disconnect();
+		signalVoid_.connect(this, &SignalTest::slotConnect);
+
+		called_ = false;
+		signalVoid_.emit();
+		if (called_) {
+			cout << "Signal connection from slot test failed" << endl;
+			return TestFail;
+		}
+
+		signalVoid_.disconnect(this, &SignalTest::slotConnect);
+		signalVoid_.emit();
+		if (!called_) {
+			cout << "Signal connection from slot test failed" << endl;
+			return TestFail;
+		}
+
 		/* ----------------- Signal -> Object tests ----------------- */
 
 		/*
@@ -256,6 +313,21 @@ protected:
 
 		delete slotMulti;
 
+		/*
+		 * Test deletion of the signal from a slot. The emission shall
+		 * stop, and shall not access the signal anymore. This shall
+		 * not generate any valgrind warning.
+		 */
+		dynamicSignal_ = new Signal<>();
+		dynamicSignal_->connect(this, &SignalTest::slotDelete);
+		dynamicSignal_->connect(this, &SignalTest::slotDelete);
+		called_ = false;
+		dynamicSignal_->emit();
+		if (!called_ || dynamicSignal_) {
+			cout << "Signal deletion from slot test failed" << endl;
+			return TestFail;
+		}
+
 		return TestPass;
 	}
 
@@ -264,6 +336,7 @@ protected:
 	}
 
 private:
+	Signal<> *dynamicSignal_;
 	Signal<> signalVoid_;
 	Signal<int> signalInt_;
 	Signal<int, const std::string &> signalMultiArgs_;
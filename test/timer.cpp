@@ -6,6 +6,8 @@
  */
 
 #include <iostream>
+#include <memory>
+#include <vector>
 
 #include <libcamera/camera_manager.h>
 #include <libcamera/event_dispatcher.h>
@@ -41,6 +43,11 @@ public:
 		return abs(duration - interval_);
 	}
 
+	bool expired() const
+	{
+		return expiration_.tv_sec || expiration_.tv_nsec;
+	}
+
 private:
 	void timeoutHandler(Timer *timer)
 	{
@@ -152,6 +159,68 @@ protected:
 			return TestFail;
 		}
 
+		/*
+		 * Run a large number of concurrent timers with interleaved
+		 * deadlines, stopping and restarting some of them, and check
+		 * that all timers that are still running expire on time.
+		 */
+		const unsigned int numTimers = 5000;
+		std::vector<std::unique_ptr<ManagedTimer>> timers;
+
+		for (unsigned int i = 0; i < numTimers; ++i) {
+			timers.emplace_back(new ManagedTimer());
+			timers.back()->start(100 + (i * 7919) % 400);
+		}
+
+		for (unsigned int i = 0; i < numTimers; i += 3)
+			timers[i]->stop();
+
+		for (unsigned int i = 0; i < numTimers; i += 5)
+			timers[i]->start(100 + (i * 104729) % 400);
+
+		struct timespec start;
+		clock_gettime(CLOCK_MONOTONIC, &start);
+
+		while (true) {
+			unsigned int running = 0;
+			for (const auto &t : timers) {
+				if (t->isRunning())
+					running++;
+			}
+
+			if (!running)
+				break;
+
+			struct timespec now;
+			clock_gettime(CLOCK_MONOTONIC, &now);
+			if (now.tv_sec - start.tv_sec > 2) {
+				cout << "Stress test timed out with " << running
+				     << " running timers" << endl;
+				return TestFail;
+			}
+
+			dispatcher->processEvents();
+		}
+
+		for (unsigned int i = 0; i < numTimers; ++i) {
+			ManagedTimer *t = timers[i].get();
+			bool stopped = i % 3 == 0 && i % 5 != 0;
+
+			if (stopped && t->expired()) {
+				cout << "Stress test: stopped timer " << i
+				     << " expired" << endl;
+				return TestFail;
+			}
+
+			if (!stopped && (!t->expired() || t->jitter() > 50)) {
+				cout << "Stress test: timer " << i
+				     << " failed to expire on time" << endl;
+				return TestFail;
+			}
+		}
+
+		timers.clear();
+
 		/*
 		 * Test that dynamically allocated timers are stopped when
 		 * deleted. This will result in a crash on failure.
@@ -0,0 +1,271 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * trace.cpp - Trace event recording test
+ */
+
+#include <chrono>
+#include <ctype.h>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <stdlib.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "trace.h"
+#include "test.h"
+
+using namespace std;
+using namespace libcamera;
+
+namespace {
+
+struct TraceEvent {
+	map<string, string> strings;
+	map<string, double> numbers;
+};
+
+/*
+ * Minimal parser for the subset of JSON emitted by the tracer: an array of
+ * flat objects whose values are strings or numbers.
+ */
+class TraceParser
+{
+public:
+	TraceParser(const string &data)
+		: data_(data), pos_(0)
+	{
+	}
+
+	bool parse(vector<TraceEvent> *events)
+	{
+		if (!consume('['))
+			return false;
+
+		if (!consume(']')) {
+			do {
+				TraceEvent event;
+				if (!parseEvent(&event))
+					return false;
+				events->push_back(event);
+			} while (consume(','));
+
+			if (!consume(']'))
+				return false;
+		}
+
+		skipSpaces();
+		return pos_ == data_.size();
+	}
+
+private:
+	void skipSpaces()
+	{
+		while (pos_ < data_.size() && isspace(data_[pos_]))
+			pos_++;
+	}
+
+	bool consume(char c)
+	{
+		skipSpaces();
+		if (pos_ >= data_.size() || data_[pos_] != c)
+			return false;
+
+		pos_++;
+		return true;
+	}
+
+	bool parseString(string *value)
+	{
+		if (!consume('"'))
+			return false;
+
+		size_t end = data_.find('"', pos_);
+		if (end == string::npos)
+			return false;
+
+		*value = data_.substr(pos_, end - pos_);
+		pos_ = end + 1;
+		return value->find('\\') == string::npos;
+	}
+
+	bool parseNumber(double *value)
+	{
+		skipSpaces();
+
+		const char *start = data_.c_str() + pos_;
+		char *end;
+		*value = strtod(start, &end);
+		if (end == start)
+			return false;
+
+		pos_ += end - start;
+		return true;
+	}
+
+	bool parseEvent(TraceEvent *event)
+	{
+		if (!consume('{'))
+			return false;
+
+		do {
+			string key;
+			if (!parseString(&key) || !consume(':'))
+				return false;
+
+			skipSpaces();
+			if (pos_ < data_.size() && data_[pos_] == '"') {
+				if (!parseString(&event->strings[key]))
+					return false;
+			} else {
+				if (!parseNumber(&event->numbers[key]))
+					return false;
+			}
+		} while (consume(','));
+
+		return consume('}');
+	}
+
+	const string &data_;
+	size_t pos_;
+};
+
+string readFile(const string &path)
+{
+	ifstream file(path);
+	return string((istreambuf_iterator<char>(file)),
+		      istreambuf_iterator<char>());
+}
+
+} /* namespace */
+
+class TraceTest : public Test
+{
+protected:
+	int init() override
+	{
+		/*
+		 * The trace file must be set before the tracer is created,
+		 * which happens before main() is called. It is thus set in the
+		 * environment by the test runner.
+		 */
+		const char *path = getenv("LIBCAMERA_TRACE_FILE");
+		if (!path || !Tracer::enabled()) {
+			cerr << "Trace file not set" << endl;
+			return TestSkip;
+		}
+
+		path_ = path;
+
+		return TestPass;
+	}
+
+	int run() override
+	{
+		/* The first event is flushed to the file right away. */
+		{
+			TRACE_SCOPE(test, "first");
+		}
+
+		if (readFile(path_).find("\"first\"") == string::npos) {
+			cerr << "Trace event not flushed" << endl;
+			return TestFail;
+		}
+
+		{
+			TRACE_SCOPE(test, "outer");
+			{
+				TRACE_SCOPE(test, "inner");
+				this_thread::sleep_for(chrono::milliseconds(1));
+			}
+		}
+
+		thread worker([]() {
+			TRACE_SCOPE(test, "thread");
+		});
+		worker.join();
+
+		Tracer::instance()->stop();
+
+		/* Events recorded after stop() are discarded. */
+		{
+			TRACE_SCOPE(test, "stopped");
+		}
+
+		if (Tracer::enabled()) {
+			cerr << "Tracing still enabled after stop" << endl;
+			return TestFail;
+		}
+
+		string data = readFile(path_);
+		vector<TraceEvent> events;
+		if (!TraceParser(data).parse(&events)) {
+			cerr << "Failed to parse trace file" << endl;
+			return TestFail;
+		}
+
+		map<string, TraceEvent> named;
+		for (const TraceEvent &event : events) {
+			auto name = event.strings.find("name");
+			auto cat = event.strings.find("cat");
+			auto ph = event.strings.find("ph");
+			if (name == event.strings.end() ||
+			    cat == event.strings.end() || cat->second != "test")
+				continue;
+
+			if (ph == event.strings.end() || ph->second != "X" ||
+			    !event.numbers.count("ts") || !event.numbers.count("dur") ||
+			    !event.numbers.count("pid") || !event.numbers.count("tid")) {
+				cerr << "Malformed event " << name->second << endl;
+				return TestFail;
+			}
+
+			named[name->second] = event;
+		}
+
+		const vector<string> expected = { "first", "outer", "inner", "thread" };
+		if (named.size() != expected.size()) {
+			cerr << "Expected " << expected.size() << " events, got "
+			     << named.size() << endl;
+			return TestFail;
+		}
+
+		for (const string &name : expected) {
+			if (!named.count(name)) {
+				cerr << "Missing event " << name << endl;
+				return TestFail;
+			}
+		}
+
+		TraceEvent &outer = named["outer"];
+		TraceEvent &inner = named["inner"];
+		if (inner.numbers["ts"] < outer.numbers["ts"] ||
+		    inner.numbers["ts"] + inner.numbers["dur"] >
+		    outer.numbers["ts"] + outer.numbers["dur"]) {
+			cerr << "Inner event not nested in outer event" << endl;
+			return TestFail;
+		}
+
+		if (inner.numbers["dur"] < 1000) {
+			cerr << "Invalid inner event duration "
+			     << inner.numbers["dur"] << "us" << endl;
+			return TestFail;
+		}
+
+		if (named["thread"].numbers["tid"] == outer.numbers["tid"] ||
+		    named["thread"].numbers["pid"] != outer.numbers["pid"]) {
+			cerr << "Invalid thread event identifiers" << endl;
+			return TestFail;
+		}
+
+		return TestPass;
+	}
+
+private:
+	string path_;
+};
+
+TEST_REGISTER(TraceTest)
@@ -0,0 +1,128 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * libcamera V4L2 API tests
+ *
+ * Measure the CPU read bandwidth of captured buffers accessed through
+ * CpuAccess.
+ */
+
+#include <iostream>
+
+#include <libcamera/buffer.h>
+#include <libcamera/camera_manager.h>
+#include <libcamera/event_dispatcher.h>
+#include <libcamera/timer.h>
+
+#include "utils.h"
+#include "v4l2_videodevice_test.h"
+
+class CpuAccessTest : public V4L2VideoDeviceTest
+{
+public:
+	CpuAccessTest()
+		: V4L2VideoDeviceTest("vimc", "Raw Capture 0"), frames_(0),
+		  bytes_(0), readTime_(0), checksum_(0), status_(TestPass)
+	{
+	}
+
+	void receiveBuffer(Buffer *buffer)
+	{
+		BufferMemory *mem = &pool_.buffers()[buffer->index()];
+		uint64_t start = utils::clock_monotonic();
+
+		{
+			CpuAccess access(mem, CpuAccess::Read);
+			if (!access.isValid()) {
+				std::cout << "Failed to start CPU access" << std::endl;
+				status_ = TestFail;
+				return;
+			}
+
+			for (Plane &plane : mem->planes()) {
+				const uint64_t *data =
+					static_cast<const uint64_t *>(plane.mem());
+				if (!data) {
+					std::cout << "Failed to map plane" << std::endl;
+					status_ = TestFail;
+					return;
+				}
+
+				unsigned int count = plane.length() / sizeof(*data);
+				for (unsigned int i = 0; i < count; ++i)
+					checksum_ ^= data[i];
+
+				bytes_ += plane.length();
+			}
+		}
+
+		readTime_ += utils::clock_monotonic() - start;
+		frames_++;
+
+		capture_->queueBuffer(buffer);
+	}
+
+protected:
+	int run()
+	{
+		const unsigned int bufferCount = 8;
+
+		EventDispatcher *dispatcher = CameraManager::instance()->eventDispatcher();
+		Timer timeout;
+		int ret;
+
+		pool_.createBuffers(bufferCount);
+
+		ret = capture_->exportBuffers(&pool_);
+		if (ret)
+			return TestFail;
+
+		capture_->bufferReady.connect(this, &CpuAccessTest::receiveBuffer);
+
+		std::vector<std::unique_ptr<Buffer>> buffers;
+		buffers = capture_->queueAllBuffers();
+		if (buffers.empty())
+			return TestFail;
+
+		ret = capture_->streamOn();
+		if (ret)
+			return TestFail;
+
+		timeout.start(10000);
+		while (timeout.isRunning() && status_ == TestPass) {
+			dispatcher->processEvents();
+			if (frames_ >= 30)
+				break;
+		}
+
+		ret = capture_->streamOff();
+		if (ret)
+			return TestFail;
+
+		if (status_ != TestPass)
+			return status_;
+
+		if (frames_ < 30) {
+			std::cout << "Failed to capture 30 frames within timeout." << std::endl;
+			return TestFail;
+		}
+
+		std::cout << "Read " << frames_ << " frames, checksum 0x"
+			  << std::hex << checksum_ << std::dec << std::endl;
+		std::cout << "Read bandwidth: "
+			  << bytes_ * 1000 / (readTime_ ? readTime_ : 1)
+			  << " MB/s" << std::endl;
+
+		return TestPass;
+	}
+
+private:
+	unsigned int frames_;
+	uint64_t bytes_;
+	uint64_t readTime_;
+	uint64_t checksum_;
+	int status_;
+};
+
+TEST_REGISTER(CpuAccessTest);
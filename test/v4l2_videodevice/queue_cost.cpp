@@ -0,0 +1,135 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * libcamera V4L2 API tests
+ *
+ * Measure the per-frame CPU cost of queuing and dequeuing buffers.
+ */
+
+#include <iostream>
+#include <unistd.h>
+
+#include <libcamera/buffer.h>
+#include <libcamera/camera_manager.h>
+#include <libcamera/event_dispatcher.h>
+#include <libcamera/timer.h>
+
+#include "utils.h"
+#include "v4l2_videodevice_test.h"
+
+class QueueCostTest : public V4L2VideoDeviceTest
+{
+public:
+	QueueCostTest()
+		: V4L2VideoDeviceTest("vimc", "Raw Capture 0")
+	{
+	}
+
+	void receiveBuffer(Buffer *buffer)
+	{
+		completed_.push_back(buffer);
+	}
+
+protected:
+	/*
+	 * Queuing and dequeuing a buffer costs one ioctl and a few table
+	 * lookups, in the order of a few microseconds per frame. The bounds
+	 * leave an order of magnitude of margin for slow machines, and catch
+	 * regressions that would add allocations or searches scaling with the
+	 * number of buffers.
+	 */
+	static constexpr uint64_t MaxQueueCost = 50000;
+	static constexpr uint64_t MaxDequeueCost = 100000;
+
+	int run()
+	{
+		const unsigned int bufferCount = 8;
+		const unsigned int rounds = 10;
+
+		EventDispatcher *dispatcher = CameraManager::instance()->eventDispatcher();
+		uint64_t queueTime = 0;
+		uint64_t dequeueTime = 0;
+		unsigned int frames = 0;
+		Timer timeout;
+		int ret;
+
+		pool_.createBuffers(bufferCount);
+
+		ret = capture_->exportBuffers(&pool_);
+		if (ret)
+			return TestFail;
+
+		capture_->bufferReady.connect(this, &QueueCostTest::receiveBuffer);
+
+		std::vector<std::unique_ptr<Buffer>> buffers;
+		for (unsigned int i = 0; i < bufferCount; ++i)
+			buffers.emplace_back(new Buffer(i));
+
+		completed_.reserve(bufferCount);
+
+		ret = capture_->streamOn();
+		if (ret)
+			return TestFail;
+
+		/*
+		 * Each round queues all buffers, lets the device complete them
+		 * without dispatching events, and then dequeues them. As all
+		 * buffers are ready by the time events are processed, the
+		 * measured dequeue time doesn't include waiting for frames.
+		 */
+		timeout.start(10000);
+		for (unsigned int round = 0; round < rounds; ++round) {
+			completed_.clear();
+
+			uint64_t start = utils::clock_monotonic();
+			for (std::unique_ptr<Buffer> &buffer : buffers) {
+				if (capture_->queueBuffer(buffer.get()))
+					return TestFail;
+			}
+			queueTime += utils::clock_monotonic() - start;
+
+			/* vimc produces frames at 60fps, leave ample margin. */
+			usleep(bufferCount * 2 * 16667);
+
+			start = utils::clock_monotonic();
+			while (completed_.size() < bufferCount && timeout.isRunning())
+				dispatcher->processEvents();
+			dequeueTime += utils::clock_monotonic() - start;
+
+			if (completed_.size() < bufferCount) {
+				std::cout << "Failed to capture frames within timeout"
+					  << std::endl;
+				return TestFail;
+			}
+
+			frames += completed_.size();
+		}
+
+		ret = capture_->streamOff();
+		if (ret)
+			return TestFail;
+
+		std::cout << "Processed " << frames << " frames" << std::endl;
+		std::cout << "Queue cost: " << queueTime / frames
+			  << " ns/frame" << std::endl;
+		std::cout << "Dequeue cost: " << dequeueTime / frames
+			  << " ns/frame" << std::endl;
+
+		if (queueTime / frames > MaxQueueCost ||
+		    dequeueTime / frames > MaxDequeueCost) {
+			std::cout << "Per-frame cost exceeds "
+				  << MaxQueueCost << " ns to queue or "
+				  << MaxDequeueCost << " ns to dequeue"
+				  << std::endl;
+			return TestFail;
+		}
+
+		return TestPass;
+	}
+
+private:
+	std::vector<Buffer *> completed_;
+};
+
+TEST_REGISTER(QueueCostTest);
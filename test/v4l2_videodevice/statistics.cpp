@@ -0,0 +1,155 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * libcamera V4L2 API tests
+ *
+ * Test the frame delivery statistics of a video device.
+ */
+
+#include <iostream>
+#include <unistd.h>
+
+#include <libcamera/buffer.h>
+#include <libcamera/camera_manager.h>
+#include <libcamera/event_dispatcher.h>
+#include <libcamera/stream.h>
+#include <libcamera/timer.h>
+
+#include "v4l2_videodevice_test.h"
+
+class StatisticsTest : public V4L2VideoDeviceTest
+{
+public:
+	StatisticsTest()
+		: V4L2VideoDeviceTest("vimc", "Raw Capture 0"), frames_(0),
+		  gaps_(0), sequence_(0)
+	{
+	}
+
+	void receiveBuffer(Buffer *buffer)
+	{
+		if (buffer->status() != Buffer::BufferSuccess)
+			return;
+
+		/* Track the sequence gaps to check the dropped frames count. */
+		if (frames_ && buffer->sequence() > sequence_ + 1)
+			gaps_ += buffer->sequence() - sequence_ - 1;
+		sequence_ = buffer->sequence();
+
+		frames_++;
+	}
+
+protected:
+	int run()
+	{
+		const unsigned int bufferCount = 4;
+
+		EventDispatcher *dispatcher = CameraManager::instance()->eventDispatcher();
+		Timer timeout;
+		int ret;
+
+		pool_.createBuffers(bufferCount);
+
+		ret = capture_->exportBuffers(&pool_);
+		if (ret)
+			return TestFail;
+
+		capture_->bufferReady.connect(this, &StatisticsTest::receiveBuffer);
+
+		std::vector<std::unique_ptr<Buffer>> buffers;
+		buffers = capture_->queueAllBuffers();
+		if (buffers.empty())
+			return TestFail;
+
+		StreamStatistics initial = capture_->statistics();
+
+		ret = capture_->streamOn();
+		if (ret)
+			return TestFail;
+
+		/* Capture all buffers without requeuing them to starve the device. */
+		timeout.start(10000);
+		while (timeout.isRunning() && frames_ < bufferCount)
+			dispatcher->processEvents();
+
+		if (frames_ < bufferCount) {
+			std::cout << "Failed to capture frames" << std::endl;
+			return TestFail;
+		}
+
+		usleep(100000);
+
+		/* Requeue all buffers and capture again after the starvation. */
+		for (std::unique_ptr<Buffer> &buffer : buffers) {
+			if (capture_->queueBuffer(buffer.get()))
+				return TestFail;
+		}
+
+		timeout.start(10000);
+		while (timeout.isRunning() && frames_ < bufferCount * 2)
+			dispatcher->processEvents();
+
+		if (frames_ < bufferCount * 2) {
+			std::cout << "Failed to capture frames after starvation"
+				  << std::endl;
+			return TestFail;
+		}
+
+		/* Requeue one buffer and stop the stream before it completes. */
+		if (capture_->queueBuffer(buffers[0].get()))
+			return TestFail;
+
+		ret = capture_->streamOff();
+		if (ret)
+			return TestFail;
+
+		StreamStatistics stats = capture_->statistics();
+
+		if (stats.frames - initial.frames < bufferCount * 2) {
+			std::cout << "Invalid frames count " << stats.frames
+				  << std::endl;
+			return TestFail;
+		}
+
+		if (stats.underrunTime - initial.underrunTime < 100000000ULL) {
+			std::cout << "Underrun time " << stats.underrunTime
+				  << " ns too short" << std::endl;
+			return TestFail;
+		}
+
+		if (stats.cancelled - initial.cancelled != 1) {
+			std::cout << "Invalid cancelled count " << stats.cancelled
+				  << std::endl;
+			return TestFail;
+		}
+
+		/*
+		 * Drivers that keep counting frames while starved, such as
+		 * sensors that free-run, report the frames dropped during the
+		 * starvation as sequence gaps. Others, such as vimc, don't
+		 * produce any gap. In both cases the dropped frames count
+		 * must grow by the gaps observed by the test.
+		 */
+		if (stats.droppedFrames - initial.droppedFrames != gaps_) {
+			std::cout << "Invalid dropped frames count "
+				  << stats.droppedFrames << ", expected "
+				  << gaps_ << std::endl;
+			return TestFail;
+		}
+
+		std::cout << "Frames: " << stats.frames
+			  << ", dropped: " << stats.droppedFrames
+			  << ", underrun: " << stats.underrunTime << " ns"
+			  << std::endl;
+
+		return TestPass;
+	}
+
+private:
+	unsigned int frames_;
+	unsigned int gaps_;
+	unsigned int sequence_;
+};
+
+TEST_REGISTER(StatisticsTest);
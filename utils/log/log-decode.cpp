@@ -0,0 +1,219 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2019, Google Inc.
+ *
+ * log-decode.cpp - Render libcamera binary log files in the text format
+ */
+
+#include <iostream>
+#include <fstream>
+#include <map>
+#include <string.h>
+#include <string>
+
+#include "log_format.h"
+
+using namespace libcamera;
+
+namespace {
+
+struct Location {
+	std::string fileName;
+	unsigned int line;
+};
+
+class LogDecoder
+{
+public:
+	LogDecoder(std::istream &input, std::ostream &output)
+		: input_(input), output_(output)
+	{
+	}
+
+	int decode();
+
+private:
+	template<typename T>
+	bool read(T *data)
+	{
+		return readData(data, sizeof(*data));
+	}
+
+	bool readData(void *data, size_t size);
+	bool readString(std::string *str, size_t length);
+
+	bool decodeCategory();
+	bool decodeLocation();
+	bool decodeMessage();
+	bool decodeDropped();
+
+	std::istream &input_;
+	std::ostream &output_;
+
+	std::map<unsigned int, std::string> categories_;
+	std::map<unsigned int, Location> locations_;
+};
+
+bool LogDecoder::readData(void *data, size_t size)
+{
+	input_.read(static_cast<char *>(data), size);
+	return static_cast<size_t>(input_.gcount()) == size;
+}
+
+bool LogDecoder::readString(std::string *str, size_t length)
+{
+	str->resize(length);
+	return readData(&(*str)[0], length);
+}
+
+bool LogDecoder::decodeCategory()
+{
+	LogCategoryRecord record;
+	std::string name;
+
+	if (!read(&record) || !readString(&name, record.length))
+		return false;
+
+	categories_[record.id] = name;
+	return true;
+}
+
+bool LogDecoder::decodeLocation()
+{
+	LogLocationRecord record;
+	Location location;
+
+	if (!read(&record) || !readString(&location.fileName, record.length))
+		return false;
+
+	location.line = record.line;
+	locations_[record.id] = location;
+	return true;
+}
+
+bool LogDecoder::decodeMessage()
+{
+	LogMessageRecord record;
+	std::string msg;
+
+	if (!read(&record) || !readString(&msg, record.length))
+		return false;
+
+	auto category = categories_.find(record.category);
+	auto location = locations_.find(record.location);
+	if (category == categories_.end() || location == locations_.end()) {
+		std::cerr << "Message references an undefined category or location"
+			  << std::endl;
+		return false;
+	}
+
+	std::string timestamp;
+	log_format_timestamp(record.timestamp, &timestamp);
+
+	output_ << timestamp << log_severity_name(record.severity) << " "
+		<< category->second << " " << location->second.fileName << ":"
+		<< location->second.line << " " << msg << "\n";
+
+	return true;
+}
+
+bool LogDecoder::decodeDropped()
+{
+	LogDroppedRecord record;
+
+	if (!read(&record))
+		return false;
+
+	output_ << "[" << record.count << " log messages dropped]\n";
+	return true;
+}
+
+int LogDecoder::decode()
+{
+	LogFileHeader header;
+
+	if (!read(&header) ||
+	    memcmp(header.magic, LOG_FILE_MAGIC, sizeof(header.magic))) {
+		std::cerr << "Not a libcamera binary log file" << std::endl;
+		return 1;
+	}
+
+	if (header.version != LOG_FILE_VERSION) {
+		std::cerr << "Unsupported log file version " << header.version
+			  << std::endl;
+		return 1;
+	}
+
+	while (true) {
+		bool ret;
+
+		/* Peek at the record type, the record decoders read it again. */
+		int type = input_.peek();
+		if (type == EOF)
+			break;
+
+		switch (type) {
+		case LogRecordCategory:
+			ret = decodeCategory();
+			break;
+		case LogRecordLocation:
+			ret = decodeLocation();
+			break;
+		case LogRecordMessage:
+			ret = decodeMessage();
+			break;
+		case LogRecordDropped:
+			ret = decodeDropped();
+			break;
+		default:
+			std::cerr << "Invalid record type " << type << std::endl;
+			return 1;
+		}
+
+		/*
+		 * The last record may be truncated if the process that wrote
+		 * the log was killed. Report it and stop decoding.
+		 */
+		if (!ret) {
+			std::cerr << "Truncated or corrupted log file" << std::endl;
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+void usage(const char *argv0)
+{
+	std::cout << "Usage: " << argv0 << " [input-file]" << std::endl;
+	std::cout << "Render a libcamera binary log file in the text format."
+		  << std::endl;
+	std::cout << "The log file is read from the standard input if no"
+		  << " input file is specified." << std::endl;
+}
+
+} /* namespace */
+
+int main(int argc, char *argv[])
+{
+	if (argc > 2 ||
+	    (argc == 2 && (!strcmp(argv[1], "-h") || !strcmp(argv[1], "--help")))) {
+		usage(argv[0]);
+		return argc > 2 ? 1 : 0;
+	}
+
+	std::ifstream file;
+	if (argc == 2) {
+		file.open(argv[1], std::ios::binary);
+		if (!file.good()) {
+			std::cerr << "Failed to open input file '" << argv[1]
+				  << "'" << std::endl;
+			return 1;
+		}
+	}
+
+	std::istream &input = argc == 2 ? file : std::cin;
+
+	LogDecoder decoder(input, std::cout);
+	return decoder.decode();
+}